@@ -0,0 +1,172 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+Throughput of the parallel algorithms on big random graphs, no window is opened.
+Usage: GraphDebuggerBenchmarks [benchmark|all] [edge count] [thread count]
+The edge count defaults to 100M, the thread count to 0 which is every hardware thread (see debug::setThreadCount())
+*/
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // weight of the edge with the given index, a hash of it, so that the benchmarks can sum up weights without storing them
+    int64_t edgeWeight(uint64_t seed, size_t edge_index, int64_t max_weight) {
+        return 1 + static_cast<int64_t>(debug::mixBits64(seed ^ edge_index) % static_cast<uint64_t>(max_weight));
+    }
+
+    // random edges with about 16 per node, generated in chunks, so that the peak memory stays close to the size of the graph.
+    // Weights are edgeWeight(seed, index, max_weight), 0 makes the graph unweighted
+    debug::Graph makeRandomGraph(size_t edge_count, bool is_directed, uint64_t seed, int64_t max_weight = 0) {
+        uint32_t node_count = static_cast<uint32_t>(std::max<size_t>(edge_count / 16, 2));
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<uint32_t> node(0, node_count - 1);
+        debug::Graph::Builder builder(node_count, is_directed);
+        builder.reserve(edge_count);
+        constexpr size_t chunk_size = 1 << 20;
+        std::vector<std::pair<uint32_t, uint32_t>> chunk;
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t>> weighted_chunk;
+        for(size_t i = 0; i < edge_count; i++){
+            uint32_t u = node(rng), v = node(rng);
+            if(max_weight > 0) weighted_chunk.emplace_back(u, v, edgeWeight(seed, i, max_weight));
+            else chunk.emplace_back(u, v);
+            if(chunk.size() + weighted_chunk.size() == chunk_size || i + 1 == edge_count){
+                builder.addEdges(chunk.begin(), chunk.end());
+                builder.addEdges(weighted_chunk.begin(), weighted_chunk.end());
+                chunk.clear();
+                weighted_chunk.clear();
+            }
+        }
+        return debug::Graph(std::move(builder));
+    }
+
+    void benchmarkPageRank(size_t edge_count) {
+        auto start = Clock::now();
+        auto graph = makeRandomGraph(edge_count, true, 49);
+        std::printf("pagerank: %u nodes, %zu edges generated in %.2f s\n", graph.getNodes(), edge_count, secondsSince(start));
+
+        // the first call builds the reverse adjacency list, it's not a part of the iterations
+        debug::PageRankOptions options;
+        options.max_iterations = 1;
+        start = Clock::now();
+        graph.findPageRank(options);
+        std::printf("pagerank: setup and 1 iteration %.3f s\n", secondsSince(start));
+
+        // zero tolerance never converges, so exactly max_iterations run
+        options.tolerance = 0;
+        options.max_iterations = 20;
+        start = Clock::now();
+        auto result = graph.findPageRank(options);
+        double seconds = secondsSince(start);
+        std::printf("pagerank: %u iterations in %.3f s, %.2f iterations/s, %.1f M edges/s\n",
+            result.iterations, seconds, result.iterations / seconds, result.iterations * static_cast<double>(edge_count) / seconds / 1e6);
+    }
+
+    void benchmarkDeltaStepping(size_t edge_count) {
+        auto start = Clock::now();
+        auto graph = makeRandomGraph(edge_count, true, 34, 1000);
+        std::printf("delta-stepping: %u nodes, %zu edges generated in %.2f s\n", graph.getNodes(), edge_count, secondsSince(start));
+
+        start = Clock::now();
+        auto sequential = graph.findDistancesFromNode(0);
+        double sequential_seconds = secondsSince(start);
+        std::printf("delta-stepping: sequential engine %.3f s\n", sequential_seconds);
+
+        // the default delta and a few fixed ones around it, the bucket width is the main knob
+        for(int64_t delta: {int64_t(0), int64_t(25), int64_t(100), int64_t(400)}){
+            start = Clock::now();
+            auto parallel = graph.findDistancesFromNodeParallel(0, delta);
+            double seconds = secondsSince(start);
+            std::printf("delta-stepping: delta %lld %.3f s, %.2fx the sequential engine%s\n",
+                static_cast<long long>(delta), seconds, sequential_seconds / seconds, parallel == sequential ? "" : ", DISTANCES DIFFER");
+        }
+    }
+
+    void benchmarkSpanningTree(size_t edge_count) {
+        constexpr uint64_t seed = 40;
+        constexpr int64_t max_weight = 1000000;
+        auto start = Clock::now();
+        auto graph = makeRandomGraph(edge_count, false, seed, max_weight);
+        std::printf("spanning tree: %u nodes, %zu edges generated in %.2f s\n", graph.getNodes(), edge_count, secondsSince(start));
+
+        auto forestWeight = [&](const std::vector<uint32_t>& edges) {
+            int64_t sum = 0;
+            for(uint32_t i: edges) sum += edgeWeight(seed, i, max_weight);
+            return sum;
+        };
+        start = Clock::now();
+        auto kruskal = graph.findMinimumSpanningTree();
+        double kruskal_seconds = secondsSince(start);
+        std::printf("spanning tree: Filter-Kruskal %.3f s, %zu edges, weight %lld\n", kruskal_seconds, kruskal.size(), static_cast<long long>(forestWeight(kruskal)));
+
+        start = Clock::now();
+        auto boruvka = graph.findMinimumSpanningTreeParallel();
+        double boruvka_seconds = secondsSince(start);
+        std::printf("spanning tree: Boruvka %.3f s, %zu edges, weight %lld, %.2fx Filter-Kruskal\n",
+            boruvka_seconds, boruvka.size(), static_cast<long long>(forestWeight(boruvka)), kruskal_seconds / boruvka_seconds);
+    }
+
+    void benchmarkConnectedComponents(size_t edge_count) {
+        auto start = Clock::now();
+        auto graph = makeRandomGraph(edge_count, false, 42);
+        std::printf("components: %u nodes, %zu edges generated in %.2f s\n", graph.getNodes(), edge_count, secondsSince(start));
+
+        auto countComponents = [](const std::vector<uint32_t>& component) {
+            return component.empty() ? 0 : *std::max_element(component.begin(), component.end()) + 1;
+        };
+        // strongly connected components of an undirected graph are its connected components, found by one sequential DFS
+        start = Clock::now();
+        auto sequential = graph.findStronglyConnectedComponents();
+        double sequential_seconds = secondsSince(start);
+        std::printf("components: sequential DFS %.3f s, %u components\n", sequential_seconds, countComponents(sequential));
+
+        start = Clock::now();
+        auto afforest = graph.findConnectedComponentsParallel();
+        double afforest_seconds = secondsSince(start);
+        std::printf("components: Afforest %.3f s, %u components, %.2fx the DFS\n",
+            afforest_seconds, countComponents(afforest), sequential_seconds / afforest_seconds);
+    }
+
+    const std::vector<std::pair<const char*, std::function<void(size_t)>>> benchmarks = {
+        {"pagerank", benchmarkPageRank},
+        {"delta-stepping", benchmarkDeltaStepping},
+        {"spanning-tree", benchmarkSpanningTree},
+        {"components", benchmarkConnectedComponents},
+    };
+}
+
+int main(int argc, char** argv) {
+    const char* name = argc > 1 ? argv[1] : "all";
+    size_t edge_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000000;
+    if(argc > 3) debug::setThreadCount(static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)));
+    std::printf("threads: %u\n", debug::getThreadCount());
+
+    bool found = false;
+    for(const auto& [benchmark_name, run]: benchmarks){
+        if(std::strcmp(name, "all") != 0 && std::strcmp(name, benchmark_name) != 0) continue;
+        found = true;
+        run(edge_count);
+    }
+    if(!found){
+        std::fprintf(stderr, "unknown benchmark %s, the options are: all", name);
+        for(const auto& benchmark: benchmarks) std::fprintf(stderr, " %s", benchmark.first);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
@@ -7,6 +7,8 @@
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <unordered_map>
 #include <condition_variable>
 #include <cstddef>
@@ -23,6 +25,10 @@
 #include <thread>
 #include <optional>
 #include <queue>
+#include <deque>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 
@@ -291,6 +297,76 @@ namespace debug {
 
 std::vector<std::pair<float, float>> forceDirected(std::vector<std::pair<float, float>> coords, const std::vector<std::pair<uint32_t, uint32_t>>& edges);
 
+/**
+ * @brief Picks a distinct color for every group, e.g. to pass component ids to Graph::visualize() as node_colors
+ * 
+ * @param groups group id of every node
+ * @return std::vector<uint32_t> colors encoded like 0xRRGGBB, the same for equal ids
+ */
+std::vector<uint32_t> getGroupColors(const std::vector<uint32_t>& groups);
+
+/**
+ * @brief Maps values to colors from blue for the smallest one through green to red for the biggest one, 
+ * e.g. to pass Graph::findBetweennessCentrality() to Graph::visualize() as node_colors
+ * 
+ * @param values value of every node
+ * @param log_scale spread the values as log(1 + value - smallest value), so that a few huge values don't make the rest look the same
+ * @return std::vector<uint32_t> colors encoded like 0xRRGGBB
+ */
+std::vector<uint32_t> getValueColors(const std::vector<double>& values, bool log_scale = false);
+
+/**
+ * @brief Sets the number of threads used by parallel algorithms. 0 means std::thread::hardware_concurrency()
+ */
+void setThreadCount(uint32_t thread_count);
+
+/**
+ * @brief Get the number of threads used by parallel algorithms, at least 1
+ */
+uint32_t getThreadCount();
+
+/**
+ * @brief Runs task in the calling thread and in helper_count threads of a persistent pool, returns once all of them are done.
+ * Pool threads are created on first use and reused afterwards. Calls made from inside a task or while another thread
+ * is using the pool run task in the calling thread only, so task must take its work from a shared counter
+ */
+void runOnThreadPool(uint32_t helper_count, const std::function<void()>& task);
+
+/**
+ * @brief Calls f(i) for every i in [begin, end) using getThreadCount() threads of the pool (see runOnThreadPool()).
+ * Indices are handed out in chunks from a shared counter, so uneven work gets balanced.
+ * Runs in the calling thread if there's only one thread or one chunk
+ */
+template<typename F>
+void parallelFor(size_t begin, size_t end, F&& f, size_t chunk = 1) {
+    if(begin >= end) return;
+    chunk = std::max<size_t>(chunk, 1);
+    size_t chunks = (end - begin + chunk - 1) / chunk;
+    uint32_t thread_count = static_cast<uint32_t>(std::min<size_t>(getThreadCount(), chunks));
+    if(thread_count <= 1) {
+        for(size_t i = begin; i < end; i++) f(i);
+        return;
+    }
+    std::atomic<size_t> next(begin);
+    auto worker = [&]() {
+        while(true) {
+            size_t first = next.fetch_add(chunk);
+            if(first >= end) break;
+            size_t last = std::min(end, first + chunk);
+            for(size_t i = first; i < last; i++) f(i);
+        }
+    };
+    runOnThreadPool(thread_count - 1, worker);
+}
+
+// splitmix64 finalizer: every bit of x affects every bit of the result
+inline uint64_t mixBits64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
 class GraphTab : public OpenGL::Tab {
     // the input handler
     OpenGL::InputHandler _input_handler;
@@ -332,10 +408,7 @@ class GraphTab : public OpenGL::Tab {
 
     struct PairHash {
         static size_t hash_f(size_t x) {
-            x += 0x9e3779b97f4a7c15;
-            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
-            x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
-            return x ^ (x >> 31);
+            return static_cast<size_t>(mixBits64(x));
         }
         static size_t hash_combine(size_t a, size_t b) {
             a ^= b + 0x9e3779b9 + (a << 6) + (a >> 2);
@@ -424,7 +497,8 @@ class GraphTab : public OpenGL::Tab {
     void processInput(OpenGL::Window& win);
     void draw(OpenGL::Window& win);
 
-    std::mutex _mutating_mutex;
+    // mutable, so that the const getters can lock it too
+    mutable std::mutex _mutating_mutex;
 public:
 
     GraphTab(size_t node_count, const std::vector<std::pair<uint32_t, uint32_t>>& edges, OpenGL::Window& window);
@@ -435,8 +509,11 @@ public:
     void setNodeLabels(const std::vector<std::string>& labels);
 
     std::vector<std::pair<uint32_t, uint32_t>> getEdges() const;
-    void setEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+    std::vector<std::pair<float, float>> getNodeCoords() const;
+    // replaces all edges at once, nodes are added first if the edges need more than there are
+    void setEdges(size_t node_count, const std::vector<std::pair<uint32_t, uint32_t>>& edges);
     void setEdgeColors(const std::vector<uint32_t>& colors);
+    void setEdgeColors(const std::vector<uint32_t>& edge_indices, const std::vector<uint32_t>& colors); // sets colors only for the given edges
     void setEdgeLabels(const std::vector<std::string>& labels);
     void setEdgesThickness(const std::vector<float>& thicknesses);
 };
@@ -444,6 +521,313 @@ public:
 template<class>
 constexpr bool dependent_false = false;
 
+// portable bit tricks, x must not be 0 for countTrailingZeros
+inline int popcount64(uint64_t x) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+inline int countTrailingZeros64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/**
+ * @brief Clamps a 64-bit distance into the int32_t range of the public API instead of wrapping it around
+ */
+inline int32_t saturateToInt32(int64_t value) {
+    if(value > INT32_MAX) return INT32_MAX;
+    if(value < INT32_MIN) return INT32_MIN;
+    return static_cast<int32_t>(value);
+}
+
+/*
+Dense matrix of distances stored as one flat array of int64_t, unreachable cells hold the infinity sentinel.
+Rows are padded to a multiple of block_size, so the matrix can be processed in square tiles.
+The sentinel is far above any sum of int32_t weights along a simple path, so every cell at or above infinity / 2 is unreachable
+and real distances are never mistaken for it. get() saturates distances that don't fit into int32_t.
+*/
+class DistanceMatrix{
+    uint32_t _sz;
+    size_t _stride;
+    std::vector<int64_t> _data;
+public:
+    static constexpr int64_t infinity = INT64_MAX / 4;
+    static constexpr uint32_t block_size = 64;
+
+    /**
+     * @brief Creates a matrix where every cell is unreachable, except the diagonal which is 0
+     */
+    DistanceMatrix(uint32_t size = 0);
+
+    uint32_t size() const;
+    size_t getStride() const;
+
+    /**
+     * @brief Get the distance. std::optional doesn't have a value if there's no path
+     */
+    std::optional<int32_t> get(uint32_t from, uint32_t to) const {
+        int64_t d = _data[from * _stride + to];
+        if(d >= infinity / 2) return std::nullopt;
+        return saturateToInt32(d);
+    }
+
+    void set(uint32_t from, uint32_t to, int64_t distance) {
+        _data[from * _stride + to] = distance;
+    }
+
+    const int64_t* getRow(uint32_t row) const {
+        return _data.data() + row * _stride;
+    }
+
+    int64_t* mutateRow(uint32_t row) {
+        return _data.data() + row * _stride;
+    }
+
+    /**
+     * @brief Relaxes all pairs through every intermediate node (Floyd-Warshall), tiled by block_size.
+     * Blocks of the 2nd and 3rd phases are updated in parallel. Negative cycles are not detected
+     */
+    void floydWarshall();
+
+    /**
+     * @brief Converts the matrix into the vector of vectors, std::optional doesn't have a value if there's no path
+     */
+    std::vector<std::vector<std::optional<int32_t>>> toVectors() const;
+};
+
+inline int countLeadingZeros64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+/*
+Monotone priority queue with unsigned integer keys: every pushed key must not be smaller than the last popped one.
+Push is O(1), pop is amortized O(log C), where C is the biggest difference between keys.
+Items are kept in 65 buckets by the highest bit in which the key differs from the last popped key.
+*/
+class RadixHeap{
+    std::vector<std::pair<uint64_t, uint32_t>> _buckets[65];
+    uint64_t _last;
+    size_t _size;
+
+    static size_t bucketIndex(uint64_t key, uint64_t last) {
+        return key == last ? 0 : static_cast<size_t>(64 - countLeadingZeros64(key ^ last));
+    }
+public:
+    RadixHeap();
+    void clear();
+    bool empty() const;
+    size_t size() const;
+    void push(uint64_t key, uint32_t value);
+    std::pair<uint64_t, uint32_t> pop(); // the item with the smallest key
+};
+
+/*
+Square matrix with one bit per cell.
+Every row is padded to a whole number of 64-bit words, so operations on rows go word by word (and get vectorized).
+*/
+class BitMatrix{
+    size_t _sz;
+    size_t _words_per_row;
+    std::vector<uint64_t> _bits;
+public:
+    BitMatrix(size_t size = 0);
+
+    size_t size() const;
+    size_t getWordsPerRow() const;
+
+    bool get(size_t row, size_t col) const {
+        return _bits[row * _words_per_row + (col >> 6)] >> (col & 63) & 1;
+    }
+
+    void set(size_t row, size_t col, bool value = true) {
+        uint64_t& word = _bits[row * _words_per_row + (col >> 6)];
+        uint64_t bit = uint64_t(1) << (col & 63);
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    const uint64_t* getRow(size_t row) const {
+        return _bits.data() + row * _words_per_row;
+    }
+
+    uint64_t* mutateRow(size_t row) {
+        return _bits.data() + row * _words_per_row;
+    }
+
+    void orRow(size_t dst_row, size_t src_row); // dst_row |= src_row
+    void andRow(size_t dst_row, size_t src_row); // dst_row &= src_row
+    size_t countRow(size_t row) const; // number of set bits in a row
+    size_t countAnd(size_t row_a, size_t row_b) const; // number of set bits in (row_a & row_b)
+};
+
+/*
+Sparse square matrix in CSR form: columns of the row r are _columns[_offsets[r].._offsets[r + 1]), sorted.
+Every cell is stored at most once.
+*/
+class SparseMatrix{
+    uint32_t _sz;
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _columns;
+    std::vector<int64_t> _values;
+public:
+    /**
+     * @brief Builds the matrix from cells given as {row, column}. If a cell is given more than once, the smallest value is kept
+     * 
+     * @param size number of rows (and columns)
+     * @param cells coordinates of the cells
+     * @param values values of the cells
+     */
+    SparseMatrix(uint32_t size, const std::vector<std::pair<uint32_t, uint32_t>>& cells, const std::vector<int64_t>& values);
+
+    uint32_t size() const;
+    size_t getNonZeroCount() const;
+
+    /**
+     * @brief Get the value of a cell in O(log(row length)). std::optional doesn't have a value if the cell is empty
+     */
+    std::optional<int64_t> get(uint32_t row, uint32_t col) const;
+
+    // sorted columns of the row
+    const uint32_t* getRowColumnsBegin(uint32_t row) const { return _columns.data() + _offsets[row]; }
+    const uint32_t* getRowColumnsEnd(uint32_t row) const { return _columns.data() + _offsets[row + 1]; }
+    // values of the row, in the same order as the columns
+    const int64_t* getRowValues(uint32_t row) const { return _values.data() + _offsets[row]; }
+};
+
+/*
+Disjoint set union with union by rank and path halving.
+*/
+class DisjointSets{
+    std::vector<uint32_t> _parent;
+    std::vector<uint8_t> _rank;
+public:
+    DisjointSets(uint32_t size = 0);
+
+    uint32_t size() const;
+
+    uint32_t find(uint32_t x) {
+        while(_parent[x] != x){
+            _parent[x] = _parent[_parent[x]];
+            x = _parent[x];
+        }
+        return x;
+    }
+
+    // doesn't change anything, so it can be called from several threads while no sets are united
+    uint32_t findWithoutCompression(uint32_t x) const {
+        while(_parent[x] != x) x = _parent[x];
+        return x;
+    }
+
+    bool unite(uint32_t x, uint32_t y); // false if x and y were in one set already
+};
+
+// kinds of edges met by Graph::depthFirstSearch, undirected graphs have only tree and back edges
+enum class DfsEdgeType{
+    tree = 0,
+    back = 1, // to a node on the current path
+    forward = 2, // to an already finished descendant
+    cross = 3, // to an already finished node in another branch
+};
+
+/*
+Callbacks of Graph::depthFirstSearch, every one of them is optional.
+parent_edge is the index of the tree edge the node was entered through, UINT32_MAX for roots.
+*/
+struct DfsCallbacks{
+    std::function<void(uint32_t node, uint32_t parent_edge)> preorder;
+    std::function<void(uint32_t node, uint32_t parent_edge)> postorder;
+    std::function<void(uint32_t from, uint32_t to, uint32_t edge_index, DfsEdgeType type)> edge;
+};
+
+/*
+Result of Graph::findBiconnectedComponents(). Blocks are maximal 2-connected sets of edges, bridges are blocks of one edge.
+The block-cut tree has a node for every block (0..block_count - 1) and for every articulation point (block_count + its position in articulation_points),
+a block is connected to every articulation point it contains.
+*/
+struct BiconnectedComponents{
+    std::vector<uint32_t> bridges; // edge indices
+    std::vector<uint32_t> articulation_points; // in increasing order
+    std::vector<uint32_t> edge_blocks; // block of every edge, UINT32_MAX for self-loops
+    uint32_t block_count = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> block_cut_tree;
+};
+
+/*
+Result of Graph::findCoreDecomposition(). The k-core is the biggest subgraph where every node has at least k neighbours, 
+the core number of a node is the biggest k such that the node is in the k-core.
+Every node has at most degeneracy neighbours after it in degeneracy_order.
+*/
+struct CoreDecomposition{
+    std::vector<uint32_t> core_numbers;
+    std::vector<uint32_t> degeneracy_order;
+    uint32_t degeneracy = 0; // the biggest core number
+};
+
+enum class MaxFlowAlgorithm{
+    dinic = 0,
+    push_relabel = 1, // highest-label with global relabeling and the gap heuristic
+};
+
+/*
+Result of Graph::findMaxFlow(). Flows of undirected edges are negative if they go from the second node of the edge to the first one.
+The minimum cut consists of the edges going from the source side to the other side.
+*/
+struct MaxFlow{
+    int64_t value = 0;
+    std::vector<int64_t> edge_flows;
+    std::vector<char> source_side; // nodes reachable from the source in the residual graph
+};
+
+/*
+Result of Graph::findTopologicalSort(). If the graph has a cycle, cycle is one of them as nodes cycle[0] -> cycle[1] -> ... -> cycle[0]
+and order has only the nodes which can't be reached from any cycle. Undirected edges go both ways, so an undirected graph is acyclic only without edges.
+*/
+struct TopologicalSort{
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> cycle; // empty if the graph is acyclic
+};
+
+struct HamiltonianSearchOptions{
+    bool parallel = true; // see setThreadCount()
+    std::chrono::milliseconds time_budget = std::chrono::milliseconds(0); // 0 means no limit
+    // called from the calling thread with the part of the work done, from 0 to 1. Returning false stops the search
+    std::function<bool(double)> progress;
+};
+
+struct HamiltonianSearchResult{
+    std::optional<std::vector<uint32_t>> cycle;
+    bool is_complete = true; // false if the search was stopped by the time budget or by the progress callback before finding a cycle
+};
+
+struct PageRankOptions{
+    double damping = 0.85; // probability of following an edge instead of jumping to a random node
+    double tolerance = 1e-9; // the iterations stop once the ranks change by less than that in total (L1)
+    uint32_t max_iterations = 100;
+    // weights of the nodes for the random jumps, normalized to sum up to 1 (personalized PageRank). Empty means uniform
+    std::vector<double> personalization;
+};
+
+struct PageRankResult{
+    std::vector<double> ranks; // sum up to 1
+    uint32_t iterations = 0;
+    bool is_converged = false; // false if max_iterations ran out first
+};
+
 class Graph{
     uint32_t _sz;
     uint32_t _is_directed;
@@ -451,11 +835,92 @@ class Graph{
     std::vector<std::pair<uint32_t, uint32_t>> _edges;
     std::vector<int64_t> _weights;
     std::vector<std::vector<std::pair<uint32_t, uint32_t>>> _adj_list;
+    // positions of the entries of every edge in _adj_list {in the list of u, in the list of v}, so that removal takes O(1).
+    // Built by the first addEdge/removeEdge, until then the lists are in the order of edge indices
+    std::vector<std::pair<uint32_t, uint32_t>> _adj_positions;
     
     static std::shared_ptr<OpenGL::Window> _window;
     std::mutex _window_init_mutex;
     std::thread _running_thread;
     std::weak_ptr<GraphTab> _associated_tab;
+    bool _tab_edges_outdated; // edges were added or removed after the tab was created
+    // sends the current edges to the tab if they are outdated, so that edge indices mean the same there
+    void syncTabEdges(GraphTab& tab);
+    // weights as edge labels, sent along with the edges only, since weights change only together with them
+    void setTabEdgeLabels(GraphTab& tab) const;
+
+    /*
+    Open addressing (linear probing) hash table from an edge {u, v} to the index of some edge between u and v.
+    Keys are {u, v} packed into 64 bits, the capacity is a power of two and the table is at most half full.
+    Parallel edges are linked into a list, so that the key moves to another copy in O(1) when its edge is removed.
+    */
+    class EdgeHashIndex {
+        static constexpr uint64_t _empty_key = ~uint64_t(0);
+        static constexpr uint32_t _no_copy = UINT32_MAX;
+        std::vector<uint64_t> _keys;
+        std::vector<uint32_t> _values;
+        size_t _count;
+        // {previous, next} edge between the same nodes for every edge index
+        std::vector<std::pair<uint32_t, uint32_t>> _copies;
+
+        size_t slot(uint64_t key) const;
+        size_t findSlot(uint64_t key) const; // slot of the key, or the empty one where it would go
+        void rehash(size_t capacity);
+        void insertKey(uint64_t key, uint32_t value); // the key must be absent
+        void eraseKey(uint64_t key); // the key must be present
+    public:
+        EdgeHashIndex();
+        static uint64_t key(uint32_t u, uint32_t v) { return (static_cast<uint64_t>(u) << 32) | v; }
+        void build(const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+        void clear();
+        std::optional<uint32_t> find(uint64_t key) const;
+        void insert(uint64_t key, uint32_t edge_index); // edge_index must be the number of edges indexed so far
+        void erase(uint64_t key, uint32_t edge_index);
+        void move(uint64_t key, uint32_t from, uint32_t to); // from must be the last index, to must be erased already
+    };
+
+    // built on the first lookup, kept up to date by addEdge/removeEdge afterwards
+    mutable EdgeHashIndex _edge_hash_index;
+    mutable bool _is_edge_hash_index_built;
+
+    // highlighting state of the associated tab, so that only the changed edges are sent
+    std::vector<uint32_t> _highlighted_edges;
+    bool _are_edges_dimmed;
+
+    // {smallest weight, biggest weight}, {1, 1} for unweighted graphs, computed on demand
+    mutable std::optional<std::pair<int64_t, int64_t>> _weight_range;
+    std::pair<int64_t, int64_t> getWeightRange() const;
+
+    // incoming edges of every node as {neighbour, edge index} for directed graphs, built on demand
+    mutable std::vector<std::vector<std::pair<uint32_t, uint32_t>>> _reverse_adj_list;
+    mutable bool _is_reverse_adj_list_built;
+    // _adj_list itself for undirected graphs
+    const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& getReverseAdjacencyList() const;
+
+    // Kahn's order with a witness cycle, computed on demand
+    mutable std::optional<TopologicalSort> _topological_sort;
+    const TopologicalSort& getTopologicalSort() const;
+
+    /*
+    Buffers of the single source shortest path engine, so that they are allocated once and reused between calls.
+    Distances are flat, unreachable nodes have unreachable_distance and no parent (no_parent).
+    */
+    struct ShortestPathWorkspace {
+        std::vector<int64_t> dist;
+        std::vector<uint32_t> parent;
+        std::vector<uint32_t> queue;
+        RadixHeap radix_heap;
+        std::vector<std::vector<uint32_t>> buckets;
+        // the backward half of the bidirectional search, parent points towards the target there
+        std::vector<int64_t> backward_dist;
+        std::vector<uint32_t> backward_parent;
+        // SPFA's queue and the edges it relaxed last, the first negative cycle it met as edge indices
+        std::deque<uint32_t> deque;
+        std::vector<char> in_queue;
+        std::vector<uint32_t> parent_edge;
+        std::vector<uint32_t> negative_cycle;
+    };
+    ShortestPathWorkspace _workspace;
 
     template<typename T, typename U = void>
     struct is_iterable {
@@ -487,22 +952,19 @@ class Graph{
             constexpr size_t tuple_size = std::tuple_size_v<T>;
             static_assert(tuple_size == 2 || tuple_size == 3, "can't deduce the edge type");
 
+            // every edge is read exactly once, so single-pass iterators are fine here
             for(auto it = begin; it != end; it++) {
-                uint32_t u = static_cast<uint32_t>(std::get<0>(*it));
-                uint32_t v = static_cast<uint32_t>(std::get<1>(*it));
+                const auto& edge = *it;
+                uint32_t u = static_cast<uint32_t>(std::get<0>(edge));
+                uint32_t v = static_cast<uint32_t>(std::get<1>(edge));
                 if(!_is_directed && u > v) std::swap(u, v);
                 max_node_number = std::max(max_node_number, v);
                 max_node_number = std::max(max_node_number, u);
                 _edges.emplace_back(u, v);
-            }
-
-            if constexpr (tuple_size == 3) {
-                for(auto it = begin; it != end; it++) {
-                    int64_t w = static_cast<int64_t>(std::get<2>(*it));
-                    _weights.emplace_back(w);
+                if constexpr (tuple_size == 3) {
+                    _weights.emplace_back(static_cast<int64_t>(std::get<2>(edge)));
                 }
             }
-
         }
         else if constexpr (is_iterable<T>::value) { // adjacency list
             uint32_t range_length = 0;
@@ -544,60 +1006,168 @@ class Graph{
             static_assert(dependent_false<T>, "can't deduce the type of graph");
         }
 
+        _sz = std::max(_sz, max_node_number + 1);
+        finalize(!is_edge_list && !_is_directed);
+    }
 
-        std::vector<uint32_t> indices(_edges.size());
-        std::iota(indices.begin(), indices.end(), 0);
-        if(_weights.size()) std::sort(indices.begin(), indices.end(), [&](uint32_t i, uint32_t j) { return std::tie(_edges[i].first, _edges[i].second, _weights[i]) < std::tie(_edges[j].first, _edges[j].second, _weights[j]); });
-        else std::sort(indices.begin(), indices.end(), [&](uint32_t i, uint32_t j) { return _edges[i] < _edges[j]; });
+    /*
+    Sorts _edges (and _weights along with them) and builds the adjacency list.
+    If remove_mirrored_duplicates is set, every second copy of an edge is dropped, which is what an undirected adjacency list gives us.
+    */
+    void finalize(bool remove_mirrored_duplicates);
 
-        auto argsort = [](auto& vec, std::vector<uint32_t> indices) {
-            for(uint32_t ind = 0; ind < indices.size(); ind++){
-                uint32_t v = ind;
-                while(indices[v] != ind) {
-                    std::swap(vec[v], vec[indices[v]]);
-                    uint32_t u = indices[v];
-                    indices[v] = v;
-                    v = u;
-                }
-                indices[v] = v;
-            }
-        };
+    /*
+    Returns the index of some edge between u and v, using the edge hash index.
+    */
+    std::optional<uint32_t> findEdge(uint32_t u, uint32_t v) const;
 
-        argsort(_edges, indices);
-        if(_weights.size()) argsort(_weights, indices);
-
-        if constexpr (!is_edge_list) {
-            if(!_is_directed) {
-                // we need to delete every edge duplicate, assuming the adjacency list was correct
-                bool didnt_add = 0;
-                size_t j = 0;
-                for(size_t i = 1; i < _edges.size(); i++) {
-                    if(didnt_add || _edges[j] != _edges[i]) {
-                        j++;
-                        _edges[j] = std::move(_edges[i]);
-                        if(_weights.size()) _weights[j] = std::move(_weights[i]);
-                        didnt_add = false;
-                    }
-                    else{
-                        didnt_add = true;
-                    }
-                }
-                _edges.erase(_edges.begin() + j + 1, _edges.end());
-                if(_weights.size()) _weights.erase(_weights.begin() + j + 1, _weights.end());
-            }
-        }
-        _sz = std::max(_sz, max_node_number + 1);
-        _adj_list.assign(_sz, {});
-        int i = 0;
-        for(auto &[x, y]: _edges){
-            _adj_list[x].emplace_back(y, i);
-            if(_is_directed == false) _adj_list[y].emplace_back(x, i);
-            i++;
-        }
+    /*
+    Builds _adj_positions if they aren't built yet.
+    */
+    void buildAdjacencyPositions();
 
-    }
+    /*
+    Whether the entry at the position in the adjacency list of v is the first of the two entries of an undirected self-loop.
+    */
+    bool isFirstSelfLoopEntry(uint32_t v, size_t position) const;
+
+    /*
+    Appends an edge to _edges and to the adjacency lists, weights are left to the caller.
+    */
+    uint32_t insertEdge(uint32_t u, uint32_t v);
+
+    /*
+    Called after every change of _edges, so that everything depending on them gets refreshed.
+    */
+    void onEdgesChanged();
+
+    /*
+    Single source kernels, they are thread-safe as long as every thread has its own workspace and the graph isn't changed.
+    Results are in workspace.dist and workspace.parent.
+    */
+    static constexpr int64_t unreachable_distance = INT64_MAX;
+    // nodes reachable through a negative cycle, they don't have a shortest path
+    static constexpr int64_t unbounded_distance = INT64_MIN;
+    static constexpr uint32_t no_parent = UINT32_MAX;
+    // the biggest weight for which Dial's buckets are used instead of the radix heap
+    static constexpr int64_t max_dial_weight = 1024;
+    void computeDistancesBFS(uint32_t source, ShortestPathWorkspace& workspace) const;
+    // Dijkstra over weights reweighted as w + potential[from] - potential[to], which must be non-negative. The returned distances are not reweighted back.
+    // Uses Dial's buckets for small weights and the radix heap otherwise. Without the potential weights must be non-negative
+    void computeDistancesDijkstra(uint32_t source, ShortestPathWorkspace& workspace, const std::vector<int64_t>& potential = {}) const;
+    // relaxation along the topological order in O(n + m), weights may be negative. The graph must be acyclic. With longest the biggest distances are found
+    void computeDistancesDag(uint32_t source, ShortestPathWorkspace& workspace, bool longest = false) const;
+    // queue-based Bellman-Ford with the SLF and LLL heuristics, weights may be negative. Without a source every node starts at 0 (a virtual source).
+    // Every n relaxations the parent pointers are checked for a cycle, which is always negative. Nodes reachable from it get unbounded_distance 
+    // and the search goes on without them. Returns false if a negative cycle was found, the first one is in workspace.negative_cycle then
+    bool computeDistancesSPFA(std::optional<uint32_t> source, ShortestPathWorkspace& workspace) const;
+    // picks the engine by the cached weight range: BFS, the topological order, Dijkstra or SPFA. false if a negative cycle is reachable
+    bool computeDistances(uint32_t source, ShortestPathWorkspace& workspace) const;
+    // Johnson's potentials via SPFA from a virtual source, std::nullopt if there is a negative cycle
+    std::optional<std::vector<int64_t>> findJohnsonPotentials() const;
+    // distances from every source computed in parallel, rows are passed to f(source, dist) from worker threads
+    template<typename F>
+    bool forEachSourceDistances(F&& f) const;
+    // point-to-point searches, they stop as soon as the path is known. The path is written to workspace.queue, false if there is no path
+    bool findPathBidirectionalBFS(uint32_t start, uint32_t finish, ShortestPathWorkspace& workspace) const;
+    // weights must be non-negative
+    bool findPathBidirectionalDijkstra(uint32_t start, uint32_t finish, ShortestPathWorkspace& workspace) const;
+
+    /*
+    Direction-optimizing BFS: levels are expanded top-down from the frontier while it's small and bottom-up 
+    (every unvisited node looks for a parent in the frontier bitmap) once its edges outnumber the unvisited ones.
+    level_callback(level, nodes) is called from the calling thread for every level, level 0 is {start}.
+    parent and parent_edge of the visited nodes are filled before their level is reported, start has no_parent
+    */
+    void traverseLevels(uint32_t start, bool parallel, std::vector<uint32_t>& parent, std::vector<uint32_t>& parent_edge, const std::function<void(uint32_t, const std::vector<uint32_t>&)>& level_callback) const;
+
+    /*
+    Iterative DFS over an explicit stack of frames allocated in chunks, so the depth is limited only by memory.
+    Every node is a root in increasing order if start has no value.
+    With by_edges every edge is walked once and nodes are entered again through every unused edge (Hierholzer's walk), 
+    edges are reported as tree edges then
+    */
+    void runDepthFirstSearch(std::optional<uint32_t> start, const DfsCallbacks& callbacks, bool by_edges) const;
+
+    // the subgraph induced by the nodes with core_numbers of at least k, see getCore()
+    Graph buildCore(const std::vector<uint32_t>& core_numbers, uint32_t k) const;
+
+    // state of one findHamiltonianCycle() call: pruning, the DP over masks, backtracking, time budget and progress
+    class HamiltonianSearch;
     
 public:
+
+    /*
+    Accumulates edges chunk by chunk and turns them into a Graph in one go.
+    Every edge is read exactly once, so it works with single-pass sources (streams, generators, std::istream_iterator).
+    Storage is moved into the Graph, so the peak memory stays close to the size of the final graph.
+    */
+    class Builder {
+        friend class Graph;
+
+        uint32_t _sz;
+        bool _is_directed;
+        std::vector<std::pair<uint32_t, uint32_t>> _edges;
+        std::vector<int64_t> _weights;
+    public:
+        /**
+         * @brief Creates an empty builder
+         * 
+         * @param vertice_count number of nodes in a graph, it grows if edges mention bigger nodes
+         * @param is_directed true if graph is directed
+         */
+        Builder(uint32_t vertice_count = 0, bool is_directed = false);
+
+        /**
+         * @brief Reserves space for the edges that are yet to come
+         * 
+         * @param edge_count total number of edges expected
+         */
+        void reserve(size_t edge_count);
+
+        /**
+         * @brief Adds an unweighted edge. If the graph is weighted, the edge gets the weight of 1
+         */
+        void addEdge(uint32_t u, uint32_t v);
+
+        /**
+         * @brief Adds a weighted edge. Edges that were added without a weight get the weight of 1
+         */
+        void addEdge(uint32_t u, uint32_t v, int64_t w);
+
+        /**
+         * @brief Adds a chunk of edges given as pairs {u, v} or tuples {u, v, w}. The range is traversed once
+         * 
+         * @param begin beginning of the range of edges
+         * @param end end of the range of edges
+         */
+        template<typename Iter>
+        Builder& addEdges(Iter begin, Iter end) {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            static_assert(is_tuple_like<T>::value, "can't deduce the edge type");
+            constexpr size_t tuple_size = std::tuple_size_v<T>;
+            static_assert(tuple_size == 2 || tuple_size == 3, "can't deduce the edge type");
+
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>) {
+                size_t expected = _edges.size() + static_cast<size_t>(std::distance(begin, end));
+                // growing at least geometrically, otherwise reserving for every chunk is quadratic
+                if(expected > _edges.capacity()) reserve(std::max(expected, 2 * _edges.capacity()));
+            }
+            for(auto it = begin; it != end; it++) {
+                const auto& edge = *it;
+                uint32_t u = static_cast<uint32_t>(std::get<0>(edge));
+                uint32_t v = static_cast<uint32_t>(std::get<1>(edge));
+                if constexpr (tuple_size == 3) addEdge(u, v, static_cast<int64_t>(std::get<2>(edge)));
+                else addEdge(u, v);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Get the number of edges added so far
+         */
+        size_t getEdgeCount() const;
+    };
     
     /**
      * @brief Creates a window where all graphs will be drawn. Note that until runWindowLoop() is not called, the window will be "not responding"
@@ -625,7 +1195,18 @@ public:
         _is_directed(is_directed), 
         _edges({}),
         _weights({}),
-        _adj_list({})
+        _adj_list({}),
+        _adj_positions({}),
+        _tab_edges_outdated(false),
+        _edge_hash_index(),
+        _is_edge_hash_index_built(false),
+        _highlighted_edges({}),
+        _are_edges_dimmed(false),
+        _weight_range(std::nullopt),
+        _reverse_adj_list({}),
+        _is_reverse_adj_list_built(false),
+        _topological_sort(std::nullopt),
+        _workspace()
         {
             initialize(graph.begin(), graph.end());
         }
@@ -644,11 +1225,29 @@ public:
         _is_directed(is_directed), 
         _edges({}),
         _weights({}),
-        _adj_list({})
+        _adj_list({}),
+        _adj_positions({}),
+        _tab_edges_outdated(false),
+        _edge_hash_index(),
+        _is_edge_hash_index_built(false),
+        _highlighted_edges({}),
+        _are_edges_dimmed(false),
+        _weight_range(std::nullopt),
+        _reverse_adj_list({}),
+        _is_reverse_adj_list_built(false),
+        _topological_sort(std::nullopt),
+        _workspace()
         {
             initialize(begin, end, indexing);
         }
 
+    /**
+     * @brief Constructs a graph from the edges accumulated by the builder. The builder is left empty
+     *
+     * @param builder builder with all the edges added
+     */
+    Graph(Builder&& builder);
+
     ~Graph();
     
     /**
@@ -669,60 +1268,100 @@ public:
      */
     void visualizeWithHighlightedEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges);
 
+    /**
+     * @brief Highlights edges in the already visualized graph, previously highlighted edges are dimmed back. 
+     * Only colors of the changed edges are sent, so it costs O(number of edges) only on the first call.
+     * Does nothing if the graph is not visualized
+     * 
+     * @param edges edges to be highlighted
+     */
+    void highlightEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+
+    /**
+     * @brief Same as highlightEdges(), but takes indices of the edges, e.g. the results of findMinimumSpanningTree() or findMaximumMatching()
+     * 
+     * @param edge_indices indices of the edges to be highlighted
+     */
+    void highlightEdges(const std::vector<uint32_t>& edge_indices);
+
+    /**
+     * @brief Shows the labels on the edges of the already visualized graph instead of the weights until the next visualize(), 
+     * e.g. flows of findMaxFlow(). Does nothing if the graph is not visualized
+     * 
+     * @param labels label of every edge
+     */
+    void setEdgeLabels(const std::vector<std::string>& labels);
+
     /*
     */
 
     /**
-     * @brief Generic BFS
+     * @brief Generic BFS. f is called for every edge of the BFS tree, level by level, after the whole level is discovered, 
+     * so the graph must not be changed from f
      * 
      * @param starting_node node to start bfs from
      * @param f  f must be an object (or a lambda) with an overloaded operator() that takes such arguments:
                 (current node, next node, index of an edge, graph)
-                if you want to change the graph, pass just by ref
+     * @param parallel expand every level in several threads (see setThreadCount()), f is still called from the calling thread
      */
     template<typename T>
-    void bfs(uint32_t starting_node, T& f){
-        std::queue<uint32_t> q;
-        std::vector<char> used(_sz);
-        q.push(starting_node);
-        used[starting_node] = 1;
-        while(!q.empty()){
-            auto v = q.front();
-            q.pop();
-            for(const auto& [u, index]: _adj_list[v]){
-                if(used[u]) continue;
-                f(v, u, index, *this);
-                used[u] = 1;
-                q.push(u);
-            }
-        }
+    void bfs(uint32_t starting_node, T& f, bool parallel = false){
+        std::vector<uint32_t> parent, parent_edge;
+        traverseLevels(starting_node, parallel, parent, parent_edge, [&](uint32_t level, const std::vector<uint32_t>& nodes) {
+            if(level == 0) return;
+            for(uint32_t u: nodes) f(parent[u], u, parent_edge[u], *this);
+        });
     }
 
     /**
-     * @brief Generic DFS
+     * @brief BFS which reports whole levels. Large levels are expanded bottom-up over bitmaps, 
+     * which is several times faster on graphs with a small diameter
+     * 
+     * @param starting_node node to start bfs from
+     * @param f called as f(level, nodes of the level) from the calling thread, level 0 is {starting_node}
+     * @param parallel expand every level in several threads (see setThreadCount())
+     */
+    void bfsByLevels(uint32_t starting_node, const std::function<void(uint32_t, const std::vector<uint32_t>&)>& f, bool parallel = false);
+
+    /**
+     * @brief Generic DFS. f is called for every edge of the DFS tree once the subtree of the next node is finished, 
+     * so the graph must not be changed from f
      * 
      * @param starting_node node to start dfs from
      * @param f  f must be an object (or a lambda) with an overloaded operator() that takes such arguments:
                 (current node, next node, previous node, index of an edge, graph)
-                if you want to change the graph, pass just by ref
      */
     template<typename T>
     void dfs(uint32_t node, T& f){
-        std::vector<char> used(_sz);
-        auto self = [&used, &f, this](auto& self, uint32_t v, uint32_t p){
-            used[v] = 1;
-            for(auto [u, ind]: _adj_list[v]){
-                if(u == p) continue;
-                self(self, u, v);
-            }
-            for(auto [u, ind]: _adj_list[v]){
-                if(u == p) continue;
-                f(v, u, p, ind, this);
-            }
+        std::vector<uint32_t> parent(_sz, node);
+        DfsCallbacks callbacks;
+        callbacks.edge = [&parent](uint32_t v, uint32_t u, uint32_t, DfsEdgeType type) {
+            if(type == DfsEdgeType::tree) parent[u] = v;
         };
-        self(self, node, node);
+        callbacks.postorder = [&parent, &f, this](uint32_t u, uint32_t index) {
+            if(index == no_parent) return;
+            uint32_t v = parent[u];
+            f(v, u, parent[v], index, this);
+        };
+        runDepthFirstSearch(node, callbacks, false);
     }
 
+    /**
+     * @brief DFS with an explicit stack, it doesn't overflow the call stack on deep graphs. 
+     * Every edge is classified, for undirected graphs every non-tree edge is reported once, as a back edge
+     * 
+     * @param starting_node node to start dfs from
+     * @param callbacks preorder, postorder and edge callbacks, empty ones are skipped
+     */
+    void depthFirstSearch(uint32_t starting_node, const DfsCallbacks& callbacks);
+
+    /**
+     * @brief DFS over the whole graph, every node which is not visited yet becomes a root, in increasing order
+     * 
+     * @param callbacks preorder, postorder and edge callbacks, empty ones are skipped
+     */
+    void depthFirstSearch(const DfsCallbacks& callbacks);
+
     /**
      * @brief Get the number of nodes in the graph
      * 
@@ -736,6 +1375,47 @@ public:
      * @return std::vector<std::pair<uint32_t, uint32_t>> edges
      */
     std::vector<std::pair<uint32_t, uint32_t>> getEdges();
+
+    /**
+     * @brief Get coordinates of the nodes in the visualized graph, e.g. for an A* heuristic. Empty if the graph is not visualized
+     * 
+     * @return std::vector<std::pair<float, float>> coordinates {x, y} in screen space (pixels)
+     */
+    std::vector<std::pair<float, float>> getNodeCoords();
+
+    /**
+     * @brief Adds an edge in amortized O(1), nodes are added if needed. If the graph is weighted, the edge gets the weight of 1.
+     * Note that after addition or removal the edges are no longer sorted, call compact() to sort them again
+     * 
+     * @return uint32_t index of the new edge
+     */
+    uint32_t addEdge(uint32_t u, uint32_t v);
+
+    /**
+     * @brief Adds a weighted edge in amortized O(1), nodes are added if needed. If the graph was unweighted, all other edges get the weight of 1
+     * 
+     * @return uint32_t index of the new edge
+     */
+    uint32_t addEdge(uint32_t u, uint32_t v, int64_t w);
+
+    /**
+     * @brief Removes one edge between u and v in expected O(1). The last edge takes the index of the removed one
+     * 
+     * @return true if there was such an edge
+     */
+    bool removeEdge(uint32_t u, uint32_t v);
+
+    /**
+     * @brief Removes an edge by its index in O(1). The last edge takes the index of the removed one
+     * 
+     * @param edge_index index of the edge to remove, nothing happens if there's no such edge
+     */
+    void removeEdgeAt(uint32_t edge_index);
+
+    /**
+     * @brief Sorts edges again and releases memory left after removals. Edge indices change
+     */
+    void compact();
     
     /**
      * @brief Get the adjacency matrix of the graph. std::optional doesn't have a value if there's no path
@@ -743,9 +1423,25 @@ public:
      * @return std::vector<std::vector<std::optional<int32_t>>> 
      */
     std::vector<std::vector<std::optional<int32_t>>> getAdjacencyMatrix(); 
+
+    /**
+     * @brief Get the adjacency matrix with one bit per cell, the bit is set if there is an edge
+     * 
+     * @return BitMatrix 
+     */
+    BitMatrix getAdjacencyBitMatrix() const;
+
+    /**
+     * @brief Get the adjacency matrix in CSR form. For parallel edges the smallest weight is kept, unweighted edges have the weight of 1
+     * 
+     * @return SparseMatrix 
+     */
+    SparseMatrix getSparseAdjacencyMatrix() const;
     
     /**
-     * @brief Finds distances from the first node using Dijkstra's algorithm. std::optional doesn't have a value if there's no path
+     * @brief Finds distances from the first node using Dijkstra's algorithm, or in O(n + m) along the topological order 
+     * if a weighted graph is a directed acyclic one. Negative weights are handled by SPFA (queue-based Bellman-Ford).
+     * std::optional doesn't have a value if there's no path or the node is reachable through a negative cycle
      * 
      * @param starting_node source node
      * @return std::vector<std::optional<int32_t>> vector of distances
@@ -753,7 +1449,19 @@ public:
     std::vector<std::optional<int32_t>> findDistancesFromNode(uint32_t starting_node);
 
     /**
-     * @brief Find the shortest path between start and finish. std::optional doesn't have a value if there's no path
+     * @brief Finds distances from the node using parallel delta-stepping. std::optional doesn't have a value if there's no path.
+     * Falls back to findDistancesFromNode() if there are negative weights
+     * 
+     * @param starting_node source node
+     * @param delta width of a bucket of distances, edges not heavier than delta are light. 0 picks it from the weights and the average degree
+     * @return std::vector<std::optional<int32_t>> vector of distances
+     */
+    std::vector<std::optional<int32_t>> findDistancesFromNodeParallel(uint32_t starting_node, int64_t delta = 0);
+
+    /**
+     * @brief Find the shortest path between start and finish. std::optional doesn't have a value if there's no path.
+     * Uses bidirectional BFS or Dijkstra's algorithm, which stops once the searches meet, so usually only a small part of the graph is visited.
+     * Graphs with negative weights fall back to the full single source search, there's no path through a negative cycle
      * 
      * @param start 
      * @param finish 
@@ -762,19 +1470,63 @@ public:
     std::optional<std::vector<uint32_t>> findShortestPathBetweenNodes(uint32_t start, uint32_t finish);
 
     /**
-     * @brief Finds pairwise distances using Floyd-Warshall algorithm
+     * @brief Find the shortest path between start and finish using A* search. std::optional doesn't have a value if there's no path.
+     * The heuristic must never overestimate the distance to finish, otherwise the path may be not the shortest one. 
+     * For example, Euclidean distance between getNodeCoords() of a node and finish, scaled so that no edge is shorter than it.
+     * Weights must be non-negative
+     * 
+     * @param start 
+     * @param finish 
+     * @param heuristic lower bound of the distance from a node to finish
+     * @return std::optional<std::vector<uint32_t>> 
+     */
+    std::optional<std::vector<uint32_t>> findShortestPathBetweenNodes(uint32_t start, uint32_t finish, const std::function<int64_t(uint32_t)>& heuristic);
+
+    /**
+     * @brief Finds pairwise distances. Dense weighted graphs use tiled Floyd-Warshall algorithm, 
+     * sparse ones use Dijkstra's algorithm from every node (with Johnson's reweighting if there are negative weights),
+     * unweighted ones use BFS from every node. Sources are processed in parallel
      * 
      * @return std::vector<std::vector<std::optional<int32_t>>> vector of distances
      */
     std::vector<std::vector<std::optional<int32_t>>> findPairwiseDistances();
+
+    /**
+     * @brief Same as findPairwiseDistances(), but returns a flat matrix of distances
+     * 
+     * @return DistanceMatrix 
+     */
+    DistanceMatrix findPairwiseDistanceMatrix();
+
+    /**
+     * @brief Finds pairwise distances row by row, so the whole matrix is never stored. Uses BFS or Dijkstra's algorithm from every node in parallel
+     * 
+     * @param row_callback called with (source node, distances from it) for every node. 
+     * Calls are serialized, but the order of sources is not specified. std::optional doesn't have a value if there's no path
+     */
+    void findPairwiseDistances(const std::function<void(uint32_t, const std::vector<std::optional<int32_t>>&)>& row_callback);
     
     /**
-     * @brief Finds Hamiltonian cycle. std::optional doesn't have a value if the Graph is not hamiltonian
+     * @brief Finds Hamiltonian cycle. std::optional doesn't have a value if the Graph is not hamiltonian.
+     * Same as findHamiltonianCycle(HamiltonianSearchOptions()) without a time budget
      * 
-     * @return std::optional<std::vector<uint32_t>> 
+     * @return std::optional<std::vector<uint32_t>> nodes of the cycle starting from the last node, the first node isn't repeated at the end
      */
     std::optional<std::vector<uint32_t>> findHamiltonianCycle(); 
 
+    /**
+     * @brief Finds Hamiltonian cycle. Cheap necessary conditions are checked first (degrees, connectivity, articulation points).
+     * Graphs up to max_hamiltonian_dp_nodes nodes use Held-Karp DP over masks with a bitset of path ends per mask (4 * 2^(n-1) bytes), 
+     * masks with the same number of bits are processed in parallel. Bigger graphs use parallel backtracking over the first two steps of the path
+     * 
+     * @param options parallelism, time budget and progress callback
+     * @return HamiltonianSearchResult the cycle starting from the last node, if there is one, and whether the search finished
+     */
+    HamiltonianSearchResult findHamiltonianCycle(const HamiltonianSearchOptions& options);
+
+    // the biggest graph for which findHamiltonianCycle() uses the DP, it takes 512 MB there
+    static constexpr uint32_t max_hamiltonian_dp_nodes = 28;
+
     /**
      * @brief Finds Eulerian circuit. std::optional doesn't have a value if the Graph is not eulerian
      * 
@@ -783,10 +1535,412 @@ public:
     std::optional<std::vector<uint32_t>> findEulerianCircuit();
 
     /**
-     * @brief Returns the edges of minimum spanning tree in a graph
+     * @brief Returns the edges of minimum spanning forest (a tree in every connected component) using Filter-Kruskal algorithm. 
+     * Edges are treated as undirected, edges of the same weight are taken in the order of their indices
      * 
-     * @return std::vector<uint32_t> 
+     * @return std::vector<uint32_t> indices of the edges in the order they were added to the forest
      */
     std::vector<uint32_t> findMinimumSpanningTree();
+
+    /**
+     * @brief Same as findMinimumSpanningTree(), but uses parallel Borůvka's algorithm, 
+     * the forest is the same, but the edges may come in other order
+     * 
+     * @return std::vector<uint32_t> indices of the edges
+     */
+    std::vector<uint32_t> findMinimumSpanningTreeParallel();
+
+    /**
+     * @brief Finds strongly connected components in O(n + m) using iterative Tarjan's algorithm, 
+     * for undirected graphs they are just connected components. 
+     * Pass the result to getGroupColors() to draw the graph colored by component
+     * 
+     * @return std::vector<uint32_t> component id of every node, components of directed graphs are numbered in topological order of the condensation
+     */
+    std::vector<uint32_t> findStronglyConnectedComponents();
+
+    /**
+     * @brief Builds the condensation of the graph: a node for every strongly connected component and 
+     * one edge for every pair of components connected by an edge. It's a DAG which can be visualized itself
+     * 
+     * @return Graph node i is the component i of findStronglyConnectedComponents()
+     */
+    Graph getCondensation();
+
+    /**
+     * @brief Finds connected components in parallel with Afforest algorithm: a lock-free union-find linked by CAS, 
+     * first over a couple of neighbours of every node, then over the rest edges of the nodes outside of the biggest sampled component. 
+     * Edges of directed graphs are treated as undirected (weakly connected components). 
+     * Pass the result to getGroupColors() to draw the graph colored by component
+     * 
+     * @return std::vector<uint32_t> component id of every node, components are numbered in the order of their smallest nodes
+     */
+    std::vector<uint32_t> findConnectedComponentsParallel();
+
+    /**
+     * @brief Finds betweenness centrality of every node using Brandes' algorithm, in parallel over the sources. 
+     * Takes O(n * m) for unweighted graphs and O(n * m * log(n)) for weighted ones. 
+     * Every unordered pair of nodes of an undirected graph is counted once. Pass the result to getValueColors() to see the bottlenecks
+     * 
+     * @param sample_count if it's not 0, only that many random sources are used and the sums are scaled by n / sample_count, 
+     * which is an unbiased estimate for big graphs
+     * @param seed seed of the sampling
+     * @return std::optional<std::vector<double>> centrality of every node, 
+     * std::nullopt if some weight isn't positive, as zero and negative cycles make the number of shortest paths unbounded
+     */
+    std::optional<std::vector<double>> findBetweennessCentrality(uint32_t sample_count = 0, uint64_t seed = 0);
+
+    /**
+     * @brief Finds PageRank (or personalized PageRank, see PageRankOptions::personalization) of every node by power iteration. 
+     * Every iteration is a sparse matrix-vector product over the incoming edges (pull-based CSR), rows are split between threads 
+     * by the number of edges. Edges count as many times as they occur, weights are ignored, undirected edges go both ways. 
+     * Ranks of the nodes without outgoing edges are spread as the random jumps are. Pass the ranks to getValueColors() to draw them
+     * 
+     * @param options damping, tolerance, iteration limit and personalization
+     * @return PageRankResult ranks and the number of iterations
+     */
+    PageRankResult findPageRank(const PageRankOptions& options = {});
+
+    /**
+     * @brief Finds bridges, articulation points, blocks and the block-cut tree in one O(n + m) pass of iterative low-link DFS. 
+     * Parallel edges are told apart by their indices, so they are never bridges. Edges of directed graphs are treated as undirected. 
+     * Bridges can be shown with highlightEdges()
+     * 
+     * @return BiconnectedComponents 
+     */
+    BiconnectedComponents findBiconnectedComponents();
+
+    /**
+     * @brief Finds core numbers and the degeneracy order of the nodes in O(n + m) using Batagelj-Zaversnik algorithm, 
+     * which peels off the node of the smallest remaining degree with buckets of nodes by degree. 
+     * Edges of directed graphs are treated as undirected, self-loops are ignored and parallel edges count as many times as they occur
+     * 
+     * @return CoreDecomposition core number of every node and the order they were peeled off in
+     */
+    CoreDecomposition findCoreDecomposition();
+
+    /**
+     * @brief Builds the k-core: the subgraph induced by the nodes with core numbers of at least k, weights are kept
+     * 
+     * @param k 
+     * @return Graph node i is the i-th smallest node of the k-core
+     */
+    Graph getCore(uint32_t k);
+
+    /**
+     * @brief Draws only the k-core in its own tab, so that a huge graph can be looked at without drawing all of it. 
+     * Nodes are colored by core number (see getValueColors()) and labeled with their numbers in this graph. Does nothing if the k-core is empty
+     * 
+     * @param k 
+     */
+    void visualizeCore(uint32_t k);
+
+    /**
+     * @brief Finds maximum flow from source to sink over a compact residual CSR. Weights are capacities (negative ones are 0), 
+     * unweighted edges have the capacity of 1, undirected edges can carry flow both ways
+     * 
+     * @param source 
+     * @param sink 
+     * @param algorithm Dinic's algorithm with current-arc pointers or highest-label push-relabel
+     * @return MaxFlow the value, flow of every edge and the source side of the minimum cut
+     */
+    MaxFlow findMaxFlow(uint32_t source, uint32_t sink, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::dinic);
+
+    /**
+     * @brief Checks if the graph is bipartite in O(n + m) and finds its 2-coloring. Edges of directed graphs are treated as undirected
+     * 
+     * @return std::optional<std::vector<uint8_t>> side (0 or 1) of every node, std::nullopt if there is an odd cycle
+     */
+    std::optional<std::vector<uint8_t>> findBipartition();
+
+    /**
+     * @brief Finds maximum matching of a bipartite graph using Hopcroft-Karp algorithm in O(m * sqrt(n)). 
+     * Edges of directed graphs are treated as undirected
+     * 
+     * @return std::optional<std::vector<uint32_t>> indices of the matched edges, which can be passed to highlightEdges(). std::nullopt if the graph isn't bipartite
+     */
+    std::optional<std::vector<uint32_t>> findMaximumMatching();
+
+    /**
+     * @brief Finds topological order of the nodes using Kahn's algorithm in O(n + m). If there is a cycle, one of them is returned as a witness
+     * 
+     * @return TopologicalSort the order, which has every node if the graph is acyclic, and the cycle otherwise
+     */
+    TopologicalSort findTopologicalSort();
+
+    /**
+     * @brief Finds the longest distances from the node in a directed acyclic graph in O(n + m) along the topological order, 
+     * weights may be negative. std::optional doesn't have a value if there's no path
+     * 
+     * @param starting_node source node
+     * @return std::optional<std::vector<std::optional<int32_t>>> vector of distances, std::nullopt if the graph has a cycle
+     */
+    std::optional<std::vector<std::optional<int32_t>>> findLongestDistancesFromNode(uint32_t starting_node);
+
+    /**
+     * @brief Finds the longest path between start and finish in a directed acyclic graph in O(n + m)
+     * 
+     * @param start 
+     * @param finish 
+     * @return std::optional<std::vector<uint32_t>> nodes of the path, std::nullopt if there's no path or the graph has a cycle
+     */
+    std::optional<std::vector<uint32_t>> findLongestPathBetweenNodes(uint32_t start, uint32_t finish);
+
+    /**
+     * @brief Looks for a negative cycle anywhere in the graph using SPFA from a virtual source. 
+     * A negative undirected edge is a cycle on its own, going there and back
+     * 
+     * @return std::optional<std::vector<uint32_t>> indices of the edges of the cycle in order, std::nullopt if there is none
+     */
+    std::optional<std::vector<uint32_t>> findNegativeCycle();
+};
+
+/*
+Graph with the node id type, the weight type and directedness fixed at compile time.
+Weight = void makes the graph unweighted, in that case no weight array is stored at all.
+Directed graphs store only outgoing edges, undirected ones store every edge in both adjacency ranges, so traversals never check directedness.
+Adjacency is stored in CSR form: neighbours of v are _adjacent[_offsets[v].._offsets[v + 1]).
+Edge indices are at least 32-bit, the node count is a size_t, so that every value of NodeId can be a node.
+*/
+template<typename NodeId = uint32_t, typename Weight = void, bool Directed = false>
+class BasicGraph{
+    static_assert(std::is_integral_v<NodeId> && std::is_unsigned_v<NodeId>, "node ids must be unsigned integers");
+public:
+    static constexpr bool is_weighted = !std::is_void_v<Weight>;
+    static constexpr bool is_directed = Directed;
+    using node_type = NodeId;
+    using weight_type = std::conditional_t<is_weighted, Weight, NodeId>;
+    using distance_type = weight_type;
+    // there can be more edges than nodes, so edge indices are at least 32-bit even for small node ids
+    using edge_index_type = std::common_type_t<NodeId, uint32_t>;
+
+    // pointer range over the neighbours of a node, every element is {next node, index of an edge}
+    struct Neighbours{
+        const std::pair<NodeId, edge_index_type>* first;
+        const std::pair<NodeId, edge_index_type>* last;
+        const std::pair<NodeId, edge_index_type>* begin() const { return first; }
+        const std::pair<NodeId, edge_index_type>* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+    };
+
+private:
+    struct NoWeights{};
+
+    size_t _sz;
+    std::vector<std::pair<NodeId, NodeId>> _edges;
+    std::conditional_t<is_weighted, std::vector<weight_type>, NoWeights> _weights;
+    std::vector<size_t> _offsets;
+    std::vector<std::pair<NodeId, edge_index_type>> _adjacent;
+
+    template<typename Iter>
+    void initialize(Iter begin, Iter end) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        constexpr size_t tuple_size = std::tuple_size_v<T>;
+        static_assert(tuple_size == 2 || tuple_size == 3, "can't deduce the edge type");
+        static_assert(tuple_size == 2 || is_weighted, "weighted edges given to an unweighted graph");
+
+        for(auto it = begin; it != end; it++) {
+            const auto& edge = *it;
+            NodeId u = static_cast<NodeId>(std::get<0>(edge));
+            NodeId v = static_cast<NodeId>(std::get<1>(edge));
+            if constexpr (!Directed) {
+                if(u > v) std::swap(u, v);
+            }
+            _sz = std::max({_sz, static_cast<size_t>(u) + 1, static_cast<size_t>(v) + 1});
+            _edges.emplace_back(u, v);
+            if constexpr (is_weighted) {
+                if constexpr (tuple_size == 3) _weights.push_back(static_cast<weight_type>(std::get<2>(edge)));
+                else _weights.push_back(1);
+            }
+        }
+
+        if constexpr (is_weighted) {
+            std::vector<size_t> indices(_edges.size());
+            std::iota(indices.begin(), indices.end(), size_t(0));
+            std::sort(indices.begin(), indices.end(), [&](size_t i, size_t j) { return std::tie(_edges[i], _weights[i]) < std::tie(_edges[j], _weights[j]); });
+            for(size_t ind = 0; ind < indices.size(); ind++){
+                size_t v = ind;
+                while(indices[v] != ind) {
+                    std::swap(_edges[v], _edges[indices[v]]);
+                    std::swap(_weights[v], _weights[indices[v]]);
+                    size_t u = indices[v];
+                    indices[v] = v;
+                    v = u;
+                }
+                indices[v] = v;
+            }
+        }
+        else {
+            std::sort(_edges.begin(), _edges.end());
+        }
+
+        _offsets.assign(_sz + 1, 0);
+        for(const auto& [x, y]: _edges){
+            _offsets[x + 1]++;
+            if constexpr (!Directed) _offsets[y + 1]++;
+        }
+        std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+        _adjacent.resize(_offsets.back());
+        std::vector<size_t> fill(_offsets.begin(), _offsets.end() - 1);
+        for(size_t i = 0; i < _edges.size(); i++){
+            const auto& [x, y] = _edges[i];
+            auto index = static_cast<edge_index_type>(i);
+            _adjacent[fill[x]++] = {y, index};
+            if constexpr (!Directed) _adjacent[fill[y]++] = {x, index};
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs a graph from a vector of edges given as pairs {u, v} or tuples {u, v, w}
+     * 
+     * @param edges edges of the graph
+     * @param vertice_count number of nodes in a graph
+     */
+    template<typename T>
+    BasicGraph(const std::vector<T>& edges, size_t vertice_count = 0):
+        _sz(vertice_count),
+        _edges({}),
+        _weights({}),
+        _offsets({}),
+        _adjacent({})
+        {
+            initialize(edges.begin(), edges.end());
+        }
+
+    /**
+     * @brief Constructs a graph based on range of edges given via the iterator. The range is traversed once
+     * 
+     * @param begin beginning of the range of edges
+     * @param end end of the range of edges
+     * @param vertice_count number of nodes in a graph
+     */
+    template<typename Iter>
+    BasicGraph(Iter begin, Iter end, size_t vertice_count = 0):
+        _sz(vertice_count),
+        _edges({}),
+        _weights({}),
+        _offsets({}),
+        _adjacent({})
+        {
+            initialize(begin, end);
+        }
+
+    /**
+     * @brief Get the number of nodes in the graph
+     */
+    size_t getNodes() const {
+        return _sz;
+    }
+
+    /**
+     * @brief Get the list of edges, sorted. For undirected graphs every edge is stored as {min, max}
+     */
+    const std::vector<std::pair<NodeId, NodeId>>& getEdges() const {
+        return _edges;
+    }
+
+    /**
+     * @brief Get the weight of an edge, 1 if the graph is unweighted
+     * 
+     * @param edge_index index of an edge
+     */
+    weight_type getWeight(edge_index_type edge_index) const {
+        if constexpr (is_weighted) return _weights[edge_index];
+        else return 1;
+    }
+
+    /**
+     * @brief Get the neighbours of a node as pairs {next node, index of an edge}
+     */
+    Neighbours getNeighbours(NodeId v) const {
+        return {_adjacent.data() + _offsets[v], _adjacent.data() + _offsets[v + 1]};
+    }
+
+    /**
+     * @brief Generic BFS
+     * 
+     * @param starting_node node to start bfs from
+     * @param f  f must be an object (or a lambda) with an overloaded operator() that takes such arguments:
+                (current node, next node, index of an edge, graph)
+     */
+    template<typename T>
+    void bfs(NodeId starting_node, T& f) const {
+        std::vector<NodeId> queue;
+        std::vector<char> used(_sz);
+        queue.reserve(_sz);
+        queue.push_back(starting_node);
+        used[starting_node] = 1;
+        for(size_t head = 0; head < queue.size(); head++){
+            NodeId v = queue[head];
+            for(const auto& [u, index]: getNeighbours(v)){
+                if(used[u]) continue;
+                f(v, u, index, *this);
+                used[u] = 1;
+                queue.push_back(u);
+            }
+        }
+    }
+
+    /**
+     * @brief Finds distances from the node, using BFS for unweighted graphs and Dijkstra's algorithm otherwise. std::optional doesn't have a value if there's no path
+     * 
+     * @param starting_node source node
+     * @return std::vector<std::optional<distance_type>> vector of distances
+     */
+    std::vector<std::optional<distance_type>> findDistancesFromNode(NodeId starting_node) const {
+        std::vector<std::optional<distance_type>> dist(_sz, std::nullopt);
+        dist[starting_node] = 0;
+        if constexpr (!is_weighted) {
+            auto F = [&dist](NodeId v, NodeId u, edge_index_type index, const BasicGraph& g){
+                dist[u] = static_cast<distance_type>(*dist[v] + 1);
+            };
+            bfs(starting_node, F);
+        }
+        else {
+            std::vector<char> used(_sz);
+            std::priority_queue<std::pair<distance_type, NodeId>, std::vector<std::pair<distance_type, NodeId>>, std::greater<std::pair<distance_type, NodeId>>> pq;
+            pq.push({0, starting_node});
+            while(!pq.empty()){
+                auto [c, v] = pq.top();
+                pq.pop();
+                if(used[v]) continue;
+                used[v] = 1;
+                for(const auto& [u, i]: getNeighbours(v)){
+                    if(used[u]) continue;
+                    distance_type nc = c + _weights[i];
+                    if(dist[u].has_value() == false || nc < *dist[u]){
+                        dist[u] = nc;
+                        pq.push({nc, u});
+                    }
+                }
+            }
+        }
+        return dist;
+    }
+
+    /**
+     * @brief Converts the graph into a debug::Graph, which can be visualized. Node ids must fit into uint32_t
+     * 
+     * @return Graph 
+     */
+    Graph toGraph() const {
+        if constexpr (is_weighted) {
+            std::vector<std::tuple<uint32_t, uint32_t, int64_t>> edges;
+            edges.reserve(_edges.size());
+            for(size_t i = 0; i < _edges.size(); i++){
+                edges.emplace_back(static_cast<uint32_t>(_edges[i].first), static_cast<uint32_t>(_edges[i].second), static_cast<int64_t>(_weights[i]));
+            }
+            return Graph(edges, static_cast<uint32_t>(_sz), Directed);
+        }
+        else {
+            std::vector<std::pair<uint32_t, uint32_t>> edges;
+            edges.reserve(_edges.size());
+            for(const auto& [x, y]: _edges){
+                edges.emplace_back(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+            }
+            return Graph(edges, static_cast<uint32_t>(_sz), Directed);
+        }
+    }
 };
 }
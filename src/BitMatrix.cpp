@@ -0,0 +1,45 @@
+#include "GraphDebugger.h"
+#include <cstdint>
+#include <vector>
+
+namespace debug {
+    BitMatrix::BitMatrix(size_t size):
+        _sz(size),
+        _words_per_row((size + 63) / 64),
+        _bits(_sz * _words_per_row, 0) {}
+
+    size_t BitMatrix::size() const {
+        return _sz;
+    }
+
+    size_t BitMatrix::getWordsPerRow() const {
+        return _words_per_row;
+    }
+
+    void BitMatrix::orRow(size_t dst_row, size_t src_row) {
+        uint64_t* dst = mutateRow(dst_row);
+        const uint64_t* src = getRow(src_row);
+        for(size_t i = 0; i < _words_per_row; i++) dst[i] |= src[i];
+    }
+
+    void BitMatrix::andRow(size_t dst_row, size_t src_row) {
+        uint64_t* dst = mutateRow(dst_row);
+        const uint64_t* src = getRow(src_row);
+        for(size_t i = 0; i < _words_per_row; i++) dst[i] &= src[i];
+    }
+
+    size_t BitMatrix::countRow(size_t row) const {
+        const uint64_t* words = getRow(row);
+        size_t res = 0;
+        for(size_t i = 0; i < _words_per_row; i++) res += static_cast<size_t>(popcount64(words[i]));
+        return res;
+    }
+
+    size_t BitMatrix::countAnd(size_t row_a, size_t row_b) const {
+        const uint64_t* a = getRow(row_a);
+        const uint64_t* b = getRow(row_b);
+        size_t res = 0;
+        for(size_t i = 0; i < _words_per_row; i++) res += static_cast<size_t>(popcount64(a[i] & b[i]));
+        return res;
+    }
+};
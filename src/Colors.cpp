@@ -0,0 +1,48 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace debug {
+    namespace {
+        // hue in [0, 6), saturation and value in [0, 1]
+        uint32_t hsvToRgb(double hue, double saturation, double value) {
+            double chroma = value * saturation;
+            double x = chroma * (1 - std::fabs(std::fmod(hue, 2.0) - 1));
+            double m = value - chroma;
+            double rgb[6][3] = {{chroma, x, 0}, {x, chroma, 0}, {0, chroma, x}, {0, x, chroma}, {x, 0, chroma}, {chroma, 0, x}};
+            const double* c = rgb[static_cast<int>(hue) % 6];
+            uint32_t color = 0;
+            for(int channel = 0; channel < 3; channel++){
+                color = color << 8 | static_cast<uint32_t>(std::lround((c[channel] + m) * 255));
+            }
+            return color;
+        }
+    }
+
+    std::vector<uint32_t> getGroupColors(const std::vector<uint32_t>& groups) {
+        // hues go around the circle by the golden angle, so neighbouring ids get very different colors
+        const double golden_ratio_conjugate = 0.618033988749895, saturation = 0.65, value = 0.9;
+        std::vector<uint32_t> colors(groups.size());
+        for(size_t i = 0; i < groups.size(); i++){
+            colors[i] = hsvToRgb(std::fmod(groups[i] * golden_ratio_conjugate, 1.0) * 6, saturation, value);
+        }
+        return colors;
+    }
+
+    std::vector<uint32_t> getValueColors(const std::vector<double>& values, bool log_scale) {
+        // blue (hue 4) to red (hue 0)
+        const double saturation = 0.8, value = 0.9;
+        std::vector<uint32_t> colors(values.size());
+        if(values.empty()) return colors;
+        auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+        double smallest = *min_it;
+        auto scaled = [&](double x) { return log_scale ? std::log1p(x - smallest) : x - smallest; };
+        double range = scaled(*max_it);
+        for(size_t i = 0; i < values.size(); i++){
+            double t = range > 0 ? scaled(values[i]) / range : 0;
+            colors[i] = hsvToRgb(4 * (1 - t), saturation, value);
+        }
+        return colors;
+    }
+};
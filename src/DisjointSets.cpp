@@ -0,0 +1,27 @@
+#include "GraphDebugger.h"
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    DisjointSets::DisjointSets(uint32_t size):
+        _parent(size),
+        _rank(size, 0)
+        {
+            std::iota(_parent.begin(), _parent.end(), 0);
+        }
+
+    uint32_t DisjointSets::size() const {
+        return static_cast<uint32_t>(_parent.size());
+    }
+
+    bool DisjointSets::unite(uint32_t x, uint32_t y) {
+        x = find(x);
+        y = find(y);
+        if(x == y) return false;
+        if(_rank[x] < _rank[y]) std::swap(x, y);
+        _parent[y] = x;
+        if(_rank[x] == _rank[y]) _rank[x]++;
+        return true;
+    }
+};
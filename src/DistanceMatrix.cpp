@@ -0,0 +1,97 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace debug {
+    namespace {
+        constexpr uint32_t block_size = DistanceMatrix::block_size;
+
+        // c = min(c, a (x) b) in the (min, +) semiring for block_size x block_size tiles.
+        // k goes outermost, so c may be the same tile as a or b, which is what the first two phases need.
+        // a_ik is below infinity / 2 and b is at most infinity, so the sum can't overflow int64_t
+        void minPlusBlock(int64_t* c, const int64_t* a, const int64_t* b, size_t stride) {
+            for(uint32_t k = 0; k < block_size; k++){
+                const int64_t* b_row = b + k * stride;
+                for(uint32_t i = 0; i < block_size; i++){
+                    int64_t a_ik = a[i * stride + k];
+                    if(a_ik >= DistanceMatrix::infinity / 2) continue;
+                    int64_t* c_row = c + i * stride;
+#if defined(__AVX2__)
+                    // AVX2 has no 64-bit min, so it's a compare and a blend
+                    __m256i va = _mm256_set1_epi64x(a_ik);
+                    for(uint32_t j = 0; j < block_size; j += 4){
+                        __m256i vs = _mm256_add_epi64(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_row + j)));
+                        __m256i vc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c_row + j));
+                        __m256i greater = _mm256_cmpgt_epi64(vc, vs);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c_row + j), _mm256_blendv_epi8(vc, vs, greater));
+                    }
+#else
+                    for(uint32_t j = 0; j < block_size; j++){
+                        c_row[j] = std::min(c_row[j], a_ik + b_row[j]);
+                    }
+#endif
+                }
+            }
+        }
+    }
+
+    DistanceMatrix::DistanceMatrix(uint32_t size):
+        _sz(size),
+        _stride((static_cast<size_t>(size) + block_size - 1) / block_size * block_size),
+        _data(_stride * _stride, infinity) {
+            for(uint32_t v = 0; v < _sz; v++) _data[v * _stride + v] = 0;
+        }
+
+    uint32_t DistanceMatrix::size() const {
+        return _sz;
+    }
+
+    size_t DistanceMatrix::getStride() const {
+        return _stride;
+    }
+
+    void DistanceMatrix::floydWarshall() {
+        size_t blocks = _stride / block_size;
+        auto block = [this](size_t i, size_t j) {
+            return _data.data() + i * block_size * _stride + j * block_size;
+        };
+        for(size_t k = 0; k < blocks; k++){
+            // phase 1: the diagonal block depends only on itself
+            int64_t* diagonal = block(k, k);
+            minPlusBlock(diagonal, diagonal, diagonal, _stride);
+
+            // phase 2: blocks in the same row and column as the diagonal one
+            parallelFor(0, blocks, [&](size_t j) {
+                if(j == k) return;
+                minPlusBlock(block(k, j), diagonal, block(k, j), _stride);
+                minPlusBlock(block(j, k), block(j, k), diagonal, _stride);
+            });
+
+            // phase 3: everything else, every block row is independent
+            parallelFor(0, blocks, [&](size_t i) {
+                if(i == k) return;
+                for(size_t j = 0; j < blocks; j++){
+                    if(j == k) continue;
+                    minPlusBlock(block(i, j), block(i, k), block(k, j), _stride);
+                }
+            });
+        }
+        // unreachable cells might have drifted below infinity because of negative edges
+        for(auto& d: _data){
+            if(d >= infinity / 2) d = infinity;
+        }
+    }
+
+    std::vector<std::vector<std::optional<int32_t>>> DistanceMatrix::toVectors() const {
+        std::vector<std::vector<std::optional<int32_t>>> res(_sz, std::vector<std::optional<int32_t>>(_sz, std::nullopt));
+        for(uint32_t v = 0; v < _sz; v++){
+            for(uint32_t u = 0; u < _sz; u++) res[v][u] = get(v, u);
+        }
+        return res;
+    }
+};
@@ -1,6 +1,7 @@
 #include "GraphDebugger.h"
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -20,6 +21,392 @@ namespace debug {
         _window->run();
     }
 
+    Graph::Builder::Builder(uint32_t vertice_count, bool is_directed):
+        _sz(vertice_count),
+        _is_directed(is_directed),
+        _edges({}),
+        _weights({}) {}
+
+    void Graph::Builder::reserve(size_t edge_count) {
+        _edges.reserve(edge_count);
+        if(_weights.size()) _weights.reserve(edge_count);
+    }
+
+    void Graph::Builder::addEdge(uint32_t u, uint32_t v) {
+        if(!_is_directed && u > v) std::swap(u, v);
+        _sz = std::max({_sz, u + 1, v + 1});
+        _edges.emplace_back(u, v);
+        if(_weights.size()) _weights.push_back(1);
+    }
+
+    void Graph::Builder::addEdge(uint32_t u, uint32_t v, int64_t w) {
+        if(_weights.size() < _edges.size()){
+            // the first weighted edge, everything before it was unweighted
+            _weights.reserve(_edges.capacity());
+            _weights.resize(_edges.size(), 1);
+        }
+        if(!_is_directed && u > v) std::swap(u, v);
+        _sz = std::max({_sz, u + 1, v + 1});
+        _edges.emplace_back(u, v);
+        _weights.push_back(w);
+    }
+
+    size_t Graph::Builder::getEdgeCount() const {
+        return _edges.size();
+    }
+
+    Graph::Graph(Builder&& builder):
+        _sz(std::max(builder._sz, 1u)),
+        _is_directed(builder._is_directed),
+        _edges(std::move(builder._edges)),
+        _weights(std::move(builder._weights)),
+        _adj_list({}),
+        _adj_positions({}),
+        _tab_edges_outdated(false),
+        _edge_hash_index(),
+        _is_edge_hash_index_built(false),
+        _highlighted_edges({}),
+        _are_edges_dimmed(false),
+        _weight_range(std::nullopt),
+        _reverse_adj_list({}),
+        _is_reverse_adj_list_built(false),
+        _topological_sort(std::nullopt),
+        _workspace()
+        {
+            builder._edges.clear();
+            builder._weights.clear();
+            builder._sz = 0;
+            finalize(false);
+        }
+
+    void Graph::finalize(bool remove_mirrored_duplicates) {
+        if(_weights.empty()){
+            std::sort(_edges.begin(), _edges.end());
+        }
+        else{
+            std::vector<uint32_t> indices(_edges.size());
+            std::iota(indices.begin(), indices.end(), 0);
+            std::sort(indices.begin(), indices.end(), [&](uint32_t i, uint32_t j) { return std::tie(_edges[i].first, _edges[i].second, _weights[i]) < std::tie(_edges[j].first, _edges[j].second, _weights[j]); });
+
+            // applying the permutation in place, both arrays at once
+            for(uint32_t ind = 0; ind < indices.size(); ind++){
+                uint32_t v = ind;
+                while(indices[v] != ind) {
+                    std::swap(_edges[v], _edges[indices[v]]);
+                    std::swap(_weights[v], _weights[indices[v]]);
+                    uint32_t u = indices[v];
+                    indices[v] = v;
+                    v = u;
+                }
+                indices[v] = v;
+            }
+        }
+
+        if(remove_mirrored_duplicates) {
+            // we need to delete every edge duplicate, assuming the adjacency list was correct
+            bool didnt_add = 0;
+            size_t j = 0;
+            for(size_t i = 1; i < _edges.size(); i++) {
+                if(didnt_add || _edges[j] != _edges[i]) {
+                    j++;
+                    _edges[j] = std::move(_edges[i]);
+                    if(_weights.size()) _weights[j] = std::move(_weights[i]);
+                    didnt_add = false;
+                }
+                else{
+                    didnt_add = true;
+                }
+            }
+            if(_edges.size()){
+                _edges.erase(_edges.begin() + static_cast<ptrdiff_t>(j) + 1, _edges.end());
+                if(_weights.size()) _weights.erase(_weights.begin() + static_cast<ptrdiff_t>(j) + 1, _weights.end());
+            }
+        }
+
+        _is_edge_hash_index_built = false;
+        _edge_hash_index.clear();
+        _adj_positions.clear();
+        _weight_range.reset();
+        _is_reverse_adj_list_built = false;
+        _reverse_adj_list.clear();
+        _topological_sort.reset();
+
+        std::vector<uint32_t> degree(_sz);
+        for(const auto& [x, y]: _edges){
+            degree[x]++;
+            if(_is_directed == false) degree[y]++;
+        }
+        _adj_list.assign(_sz, {});
+        for(uint32_t v = 0; v < _sz; v++) _adj_list[v].reserve(degree[v]);
+        uint32_t i = 0;
+        for(const auto& [x, y]: _edges){
+            _adj_list[x].emplace_back(y, i);
+            if(_is_directed == false) _adj_list[y].emplace_back(x, i);
+            i++;
+        }
+    }
+
+    Graph::EdgeHashIndex::EdgeHashIndex():
+        _keys({}),
+        _values({}),
+        _count(0) {}
+
+    size_t Graph::EdgeHashIndex::slot(uint64_t key) const {
+        return static_cast<size_t>(mixBits64(key)) & (_keys.size() - 1);
+    }
+
+    size_t Graph::EdgeHashIndex::findSlot(uint64_t key) const {
+        size_t i = slot(key);
+        while(_keys[i] != _empty_key && _keys[i] != key) i = (i + 1) & (_keys.size() - 1);
+        return i;
+    }
+
+    void Graph::EdgeHashIndex::rehash(size_t capacity) {
+        auto keys = std::move(_keys);
+        auto values = std::move(_values);
+        _keys.assign(capacity, _empty_key);
+        _values.assign(capacity, 0);
+        _count = 0;
+        for(size_t i = 0; i < keys.size(); i++){
+            if(keys[i] != _empty_key) insertKey(keys[i], values[i]);
+        }
+    }
+
+    void Graph::EdgeHashIndex::insertKey(uint64_t key, uint32_t value) {
+        if(2 * (_count + 1) > _keys.size()) rehash(std::max<size_t>(16, 2 * _keys.size()));
+        size_t i = findSlot(key);
+        _keys[i] = key;
+        _values[i] = value;
+        _count++;
+    }
+
+    void Graph::EdgeHashIndex::eraseKey(uint64_t key) {
+        size_t mask = _keys.size() - 1;
+        size_t i = findSlot(key);
+        // backward shift deletion, so that no tombstones are needed
+        for(size_t j = (i + 1) & mask; _keys[j] != _empty_key; j = (j + 1) & mask){
+            size_t home = slot(_keys[j]);
+            bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+            if(stays) continue;
+            _keys[i] = _keys[j];
+            _values[i] = _values[j];
+            i = j;
+        }
+        _keys[i] = _empty_key;
+        _count--;
+    }
+
+    void Graph::EdgeHashIndex::build(const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+        size_t capacity = 16;
+        while(capacity < 2 * edges.size()) capacity *= 2;
+        _keys.assign(capacity, _empty_key);
+        _values.assign(capacity, 0);
+        _count = 0;
+        _copies.clear();
+        _copies.reserve(edges.size());
+        for(uint32_t i = 0; i < edges.size(); i++){
+            insert(key(edges[i].first, edges[i].second), i);
+        }
+    }
+
+    void Graph::EdgeHashIndex::clear() {
+        _keys.clear();
+        _values.clear();
+        _count = 0;
+        _copies.clear();
+    }
+
+    std::optional<uint32_t> Graph::EdgeHashIndex::find(uint64_t key) const {
+        if(_keys.empty()) return std::nullopt;
+        size_t i = findSlot(key);
+        if(_keys[i] == _empty_key) return std::nullopt;
+        return _values[i];
+    }
+
+    void Graph::EdgeHashIndex::insert(uint64_t key, uint32_t edge_index) {
+        _copies.emplace_back(_no_copy, _no_copy);
+        auto first = find(key);
+        if(!first.has_value()){
+            insertKey(key, edge_index);
+            return;
+        }
+        // the key keeps pointing to the first copy, the new one goes right after it
+        uint32_t next = _copies[*first].second;
+        _copies[edge_index] = {*first, next};
+        _copies[*first].second = edge_index;
+        if(next != _no_copy) _copies[next].first = edge_index;
+    }
+
+    void Graph::EdgeHashIndex::erase(uint64_t key, uint32_t edge_index) {
+        auto [previous, next] = _copies[edge_index];
+        if(previous != _no_copy) _copies[previous].second = next;
+        if(next != _no_copy) _copies[next].first = previous;
+        if(previous == _no_copy){
+            if(next != _no_copy) _values[findSlot(key)] = next;
+            else eraseKey(key);
+        }
+        _copies[edge_index] = {_no_copy, _no_copy};
+        if(edge_index + 1 == _copies.size()) _copies.pop_back();
+    }
+
+    void Graph::EdgeHashIndex::move(uint64_t key, uint32_t from, uint32_t to) {
+        auto [previous, next] = _copies[from];
+        _copies[to] = _copies[from];
+        if(previous != _no_copy) _copies[previous].second = to;
+        else _values[findSlot(key)] = to;
+        if(next != _no_copy) _copies[next].first = to;
+        _copies.pop_back();
+    }
+
+    std::optional<uint32_t> Graph::findEdge(uint32_t u, uint32_t v) const {
+        if(!_is_directed && u > v) std::swap(u, v);
+        if(!_is_edge_hash_index_built){
+            _edge_hash_index.build(_edges);
+            _is_edge_hash_index_built = true;
+        }
+        return _edge_hash_index.find(EdgeHashIndex::key(u, v));
+    }
+
+    void Graph::buildAdjacencyPositions() {
+        if(_adj_positions.size() == _edges.size()) return;
+        _adj_positions.assign(_edges.size(), {no_parent, no_parent});
+        for(uint32_t v = 0; v < _sz; v++){
+            for(uint32_t j = 0; j < _adj_list[v].size(); j++){
+                uint32_t i = _adj_list[v][j].second;
+                // the first entry of a self-loop is the one seen first
+                if(_edges[i].first == v && _adj_positions[i].first == no_parent) _adj_positions[i].first = j;
+                else _adj_positions[i].second = j;
+            }
+        }
+    }
+
+    bool Graph::isFirstSelfLoopEntry(uint32_t v, size_t position) const {
+        uint32_t i = _adj_list[v][position].second;
+        // without the positions the lists are in the order of edge indices, both entries of a self-loop are next to each other
+        if(_adj_positions.size() != _edges.size()) return position == 0 || _adj_list[v][position - 1].second != i;
+        return position == std::min(_adj_positions[i].first, _adj_positions[i].second);
+    }
+
+    void Graph::onEdgesChanged() {
+        _tab_edges_outdated = true;
+        _weight_range.reset();
+        _is_reverse_adj_list_built = false;
+        _reverse_adj_list.clear();
+        _topological_sort.reset();
+    }
+
+    const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& Graph::getReverseAdjacencyList() const {
+        if(!_is_directed) return _adj_list;
+        if(!_is_reverse_adj_list_built){
+            std::vector<uint32_t> in_degree(_sz);
+            for(const auto& [x, y]: _edges) in_degree[y]++;
+            _reverse_adj_list.assign(_sz, {});
+            for(uint32_t v = 0; v < _sz; v++) _reverse_adj_list[v].reserve(in_degree[v]);
+            for(uint32_t i = 0; i < _edges.size(); i++){
+                _reverse_adj_list[_edges[i].second].emplace_back(_edges[i].first, i);
+            }
+            _is_reverse_adj_list_built = true;
+        }
+        return _reverse_adj_list;
+    }
+
+    uint32_t Graph::insertEdge(uint32_t u, uint32_t v) {
+        if(!_is_directed && u > v) std::swap(u, v);
+        if(v >= _sz || u >= _sz) {
+            _sz = std::max(u, v) + 1;
+            _adj_list.resize(_sz);
+        }
+        buildAdjacencyPositions();
+        uint32_t ind = static_cast<uint32_t>(_edges.size());
+        _edges.emplace_back(u, v);
+
+        // entries are appended, adjacency lists aren't sorted after that
+        auto insert = [this](uint32_t from, uint32_t to, uint32_t index) {
+            _adj_list[from].emplace_back(to, index);
+            return static_cast<uint32_t>(_adj_list[from].size() - 1);
+        };
+        uint32_t first = insert(u, v, ind);
+        uint32_t second = _is_directed ? no_parent : insert(v, u, ind);
+        _adj_positions.emplace_back(first, second);
+        if(_is_edge_hash_index_built) _edge_hash_index.insert(EdgeHashIndex::key(u, v), ind);
+        return ind;
+    }
+
+    uint32_t Graph::addEdge(uint32_t u, uint32_t v) {
+        uint32_t ind = insertEdge(u, v);
+        if(_weights.size()) _weights.push_back(1);
+        onEdgesChanged();
+        return ind;
+    }
+
+    uint32_t Graph::addEdge(uint32_t u, uint32_t v, int64_t w) {
+        if(_weights.size() < _edges.size()) _weights.resize(_edges.size(), 1);
+        uint32_t ind = insertEdge(u, v);
+        _weights.push_back(w);
+        onEdgesChanged();
+        return ind;
+    }
+
+    bool Graph::removeEdge(uint32_t u, uint32_t v) {
+        auto ind = findEdge(u, v);
+        if(!ind.has_value()) return false;
+        removeEdgeAt(*ind);
+        return true;
+    }
+
+    void Graph::removeEdgeAt(uint32_t edge_index) {
+        if(edge_index >= _edges.size()) return;
+        buildAdjacencyPositions();
+        // the last entry of the list takes the place of the removed one
+        auto erase = [this](uint32_t from, uint32_t position) {
+            auto& adj = _adj_list[from];
+            auto moved = adj.back();
+            adj.pop_back();
+            if(position == adj.size()) return;
+            adj[position] = moved;
+            auto& positions = _adj_positions[moved.second];
+            if(_edges[moved.second].first == from && positions.first == adj.size()) positions.first = position;
+            else positions.second = position;
+        };
+
+        auto [x, y] = _edges[edge_index];
+        auto [first, second] = _adj_positions[edge_index];
+        if(_is_directed) erase(x, first);
+        else if(x == y){
+            // the later entry goes first, so that the other one doesn't get moved
+            erase(x, std::max(first, second));
+            erase(x, std::min(first, second));
+        }
+        else{
+            erase(x, first);
+            erase(y, second);
+        }
+        if(_is_edge_hash_index_built) _edge_hash_index.erase(EdgeHashIndex::key(x, y), edge_index);
+
+        uint32_t last = static_cast<uint32_t>(_edges.size()) - 1;
+        if(edge_index != last) {
+            auto [a, b] = _edges[last];
+            _adj_list[a][_adj_positions[last].first].second = edge_index;
+            if(_is_directed == false) _adj_list[b][_adj_positions[last].second].second = edge_index;
+            _adj_positions[edge_index] = _adj_positions[last];
+            if(_is_edge_hash_index_built) _edge_hash_index.move(EdgeHashIndex::key(a, b), last, edge_index);
+            _edges[edge_index] = _edges[last];
+            if(_weights.size()) _weights[edge_index] = _weights[last];
+        }
+        _edges.pop_back();
+        _adj_positions.pop_back();
+        if(_weights.size()) _weights.pop_back();
+        onEdgesChanged();
+    }
+
+    void Graph::compact() {
+        _edges.shrink_to_fit();
+        _weights.shrink_to_fit();
+        finalize(false);
+        for(auto& adj: _adj_list) adj.shrink_to_fit();
+        onEdgesChanged();
+    }
+
     Graph::~Graph(){
         if(_running_thread.joinable()){
             std::cerr << "Waiting on window to close...\n";
@@ -31,6 +418,8 @@ namespace debug {
     void Graph::visualize(const std::vector<uint32_t>& node_colors, const std::vector<uint32_t>& edge_colors, const std::vector<std::pair<float, float>>& coords, const std::vector<float>& line_widths, const std::vector<std::string>& node_labels) {
         std::unique_lock lck(_window_init_mutex);
         if(_window == nullptr){
+            // the thread of a closed window is finishing, a joinable thread can't be replaced
+            if(_running_thread.joinable()) _running_thread.join();
             std::condition_variable cv;
             _running_thread = std::thread([&](){
             {
@@ -43,47 +432,99 @@ namespace debug {
             });
             cv.wait(lck, [&](){return _window != nullptr;});
         }
-        if(_associated_tab.expired()){
+        bool is_new_tab = _associated_tab.expired();
+        if(is_new_tab){
             _associated_tab = _window->addTab<GraphTab>(_sz, _edges, *_window);
+            _tab_edges_outdated = false;
+            _highlighted_edges.clear();
+            _are_edges_dimmed = false;
         }
 
         auto tab = _associated_tab.lock();
+        if(is_new_tab) setTabEdgeLabels(*tab);
+        syncTabEdges(*tab);
 
         if(coords.size() == _sz){
             tab->setNodeCoords(coords);
         }
-        if(_weights.size()){
-            std::vector<std::string> str_weights;
-            std::transform(_weights.begin(), _weights.end(), std::back_inserter(str_weights), [](int32_t x) { return std::to_string(x); });
-            tab->setEdgeLabels(str_weights);
-        }
         if(node_colors.size() == _sz){
             tab->setNodeColors(node_colors);
         }
-        if(edge_colors.size() == _sz){
+        if(edge_colors.size() == _edges.size()){
             tab->setEdgeColors(edge_colors);
+            _highlighted_edges.clear();
+            _are_edges_dimmed = false;
         }
         if(line_widths.size() == _edges.size()){
             tab->setEdgesThickness(line_widths);
         }
         if(node_labels.size() == _sz){
-            tab->setEdgeLabels(node_labels);
+            tab->setNodeLabels(node_labels);
         }
     }
 
     void Graph::visualizeWithHighlightedEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges){
-        std::vector<uint32_t> colors(_edges.size(), 0xEAD8C0);
+        // an open tab only needs the highlighting, highlightEdges() syncs its edges
+        if(_associated_tab.expired()) visualize();
+        highlightEdges(edges);
+    }
+
+    void Graph::highlightEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges){
+        std::vector<uint32_t> edge_indices;
         for(auto [x, y]: edges){
-            if(_is_directed == false && x > y) std::swap(x, y);
-            auto xy = std::make_pair(x, y);
-            uint32_t ind = std::lower_bound(_edges.begin(), _edges.end(), xy) - _edges.begin();
-            if(ind != _edges.size() && _edges[ind] == xy){
-                colors[ind] = 0x0; 
-            }
+            auto ind = findEdge(x, y);
+            if(ind.has_value()) edge_indices.push_back(*ind);
+        }
+        highlightEdges(edge_indices);
+    }
+
+    void Graph::highlightEdges(const std::vector<uint32_t>& edge_indices){
+        const uint32_t dimmed_color = 0xEAD8C0, highlighted_color = 0x0;
+        auto tab = _associated_tab.lock();
+        if(tab == nullptr) return;
+        syncTabEdges(*tab);
+        if(!_are_edges_dimmed){
+            tab->setEdgeColors(std::vector<uint32_t>(_edges.size(), dimmed_color));
+            _are_edges_dimmed = true;
+            _highlighted_edges.clear();
         }
-        visualize({}, colors);
+
+        std::vector<uint32_t> indices = std::move(_highlighted_edges);
+        std::vector<uint32_t> colors(indices.size(), dimmed_color);
+        _highlighted_edges.clear();
+        for(uint32_t ind: edge_indices){
+            if(ind >= _edges.size()) continue;
+            _highlighted_edges.push_back(ind);
+            indices.push_back(ind);
+            colors.push_back(highlighted_color);
+        }
+        // highlighted colors come last, so they win over the dimming of the same edge
+        tab->setEdgeColors(indices, colors);
+    }
+
+    void Graph::setEdgeLabels(const std::vector<std::string>& labels){
+        auto tab = _associated_tab.lock();
+        if(tab == nullptr) return;
+        syncTabEdges(*tab);
+        tab->setEdgeLabels(labels);
     }
 
+    void Graph::syncTabEdges(GraphTab& tab){
+        if(!_tab_edges_outdated) return;
+        tab.setEdges(_sz, _edges);
+        setTabEdgeLabels(tab);
+        _tab_edges_outdated = false;
+        _highlighted_edges.clear();
+        _are_edges_dimmed = false;
+    }
+
+    void Graph::setTabEdgeLabels(GraphTab& tab) const {
+        if(_weights.empty()) return;
+        std::vector<std::string> str_weights;
+        str_weights.reserve(_weights.size());
+        std::transform(_weights.begin(), _weights.end(), std::back_inserter(str_weights), [](int64_t x) { return std::to_string(x); });
+        tab.setEdgeLabels(str_weights);
+    }
 
     uint32_t Graph::getNodes(){
         return _sz;
@@ -93,207 +534,75 @@ namespace debug {
         return _edges;
     }
 
+    std::vector<std::pair<float, float>> Graph::getNodeCoords(){
+        auto tab = _associated_tab.lock();
+        if(tab == nullptr) return {};
+        return tab->getNodeCoords();
+    }
+
     std::vector<std::vector<std::optional<int32_t>>> Graph::getAdjacencyMatrix(){
         std::vector<std::vector<std::optional<int32_t>>> res(_sz, std::vector<std::optional<int32_t>>(_sz, std::nullopt));
-        if(_weights.empty()){
-            for(uint32_t v = 0; v < _sz; v++){
-                for(const auto& [u, i]: _adj_list[v]) res[v][u] = 1;
-            }
-        }
-        else{
-            for(uint32_t v = 0; v < _sz; v++){
-                for(const auto& [u, i]: _adj_list[v]) res[v][u] = _weights[i];
+        auto sparse = getSparseAdjacencyMatrix();
+        for(uint32_t v = 0; v < _sz; v++){
+            auto columns = sparse.getRowColumnsBegin(v);
+            auto values = sparse.getRowValues(v);
+            for(size_t i = 0; columns + i != sparse.getRowColumnsEnd(v); i++){
+                res[v][columns[i]] = static_cast<int32_t>(values[i]);
             }
         }
         return res;
     }
 
-    std::vector<std::optional<int32_t>> Graph::findDistancesFromNode(uint32_t starting_node){
-        std::vector<std::optional<int32_t>> dist(_sz, std::nullopt);
-        if(_weights.empty()){
-            dist[starting_node] = 0;
-            auto F = [&dist](uint32_t v, uint32_t u, uint32_t index, const Graph& g){
-                dist[u] = *dist[v] + 1;
-            };
-            bfs(starting_node, F);
-        }
-        else{
-            std::vector<char> used(_sz);
-            std::priority_queue<std::pair<int32_t, uint32_t>, std::vector<std::pair<int32_t, uint32_t>>, std::greater<std::pair<int32_t, uint32_t>>> pq;
-            dist[starting_node] = 0;
-            pq.push({0, starting_node});
-            while(!pq.empty()){
-                auto [c, v] = pq.top();
-                pq.pop();
-                if(used[v]) continue;
-                used[v] = 1;
-                for(auto [u, i]: _adj_list[v]){
-                    if(used[u]) continue;
-                    if(dist[u].has_value() == false || c + _weights[i] < *dist[u]){
-                        dist[u] = c + _weights[i];
-                        pq.push({*dist[u], u});
-                    }
-                }
-            }
-        }
-        return dist;
-    }
-
-    std::optional<std::vector<uint32_t>> Graph::findShortestPathBetweenNodes(uint32_t start, uint32_t finish){
-        std::vector<std::optional<int32_t>> dist(_sz, std::nullopt);
-        std::vector<std::optional<uint32_t>> parent(_sz, std::nullopt);
-        if(_weights.empty()){
-            dist[start] = 0;
-            auto F = [&dist, &parent](uint32_t v, uint32_t u, uint32_t index, const Graph& g){
-                dist[u] = *dist[v] + 1;
-                parent[u] = v;
-            };
-            bfs(start, F);
-        }
-        else{
-            std::vector<char> used(_sz);
-            std::priority_queue<std::pair<int32_t, uint32_t>, std::vector<std::pair<int32_t, uint32_t>>, std::greater<std::pair<int32_t, uint32_t>>> pq;
-            dist[start] = 0;
-            pq.push({0, start});
-            while(!pq.empty()){
-                auto [c, v] = pq.top();
-                pq.pop();
-                if(used[v]) continue;
-                used[v] = 1;
-                for(auto [u, i]: _adj_list[v]){
-                    if(used[u]) continue;
-                    if(dist[u].has_value() == false || c + _weights[i] < *dist[u]){
-                        dist[u] = c + _weights[i];
-                        parent[u] = v;
-                        pq.push({*dist[u], u});
-                    }
-                }
-            }
-        }
-        std::optional<std::vector<uint32_t>> path;
-        if(!parent[finish].has_value()) return path;
-        path = std::vector<uint32_t>();
-        path->push_back(finish);
-        while(parent[path->back()].has_value()){
-            path->push_back(*parent[path->back()]);
-        }
-        std::reverse(path->begin(), path->end());
-        return path;
-    }
-
-    std::vector<std::vector<std::optional<int32_t>>> Graph::findPairwiseDistances(){
-        if(_weights.empty()){
-            std::vector<std::vector<std::optional<int32_t>>> dist(_sz);
-            for(uint32_t start = 0; start < _sz; start++){
-                dist[start] = findDistancesFromNode(start);
-            }
-            return dist;
-        }
-        auto res = getAdjacencyMatrix();
-        for(uint32_t i = 0; i < _sz; i++){
-            res[i][i] = 0;
-        }
-        for(uint32_t mid = 0; mid < _sz; mid++){
-            for(uint32_t v = 0; v < _sz; v++){
-                if(!res[v][mid].has_value()) continue;
-                for(uint32_t u = 0; u < _sz; u++){
-                    if(u == v || !res[mid][u].has_value()) continue;
-                    if(res[v][u].has_value()) res[v][u] = std::min(*res[v][u], *res[v][mid] + *res[mid][u]);
-                    else res[v][u] = *res[v][mid] + *res[mid][u];
-                }
-            }
+    BitMatrix Graph::getAdjacencyBitMatrix() const {
+        BitMatrix res(_sz);
+        for(uint32_t v = 0; v < _sz; v++){
+            for(const auto& [u, i]: _adj_list[v]) res.set(v, u);
         }
         return res;
     }
 
-
-    std::optional<std::vector<uint32_t>> Graph::findHamiltonianCycle(){
-        auto masks = std::vector(1 << (_sz - 1), std::vector(_sz - 1, std::optional<std::pair<uint32_t, uint32_t>>(std::nullopt)));
-        auto adj_mat = getAdjacencyMatrix();
-        for(uint32_t v = 0; v + 1 < _sz; v++){
-            if(adj_mat[_sz - 1][v].has_value()) masks[0][v] = {0, _sz - 1};
-        }
-        for(uint32_t mask = 0; mask < masks.size(); mask++){
-            for(uint32_t u = 0; u + 1 < _sz; u++){
-                if(masks[mask][u].has_value() == false || (mask >> u & 1)) continue;
-                for(uint32_t v = 0; v + 1 < _sz; v++){
-                    if((mask >> v & 1) || u == v) continue;
-                    if(adj_mat[u][v].has_value()){
-                        masks[mask | (1 << u)][v] = {mask, u};
-                    }
-                }
+    SparseMatrix Graph::getSparseAdjacencyMatrix() const {
+        std::vector<std::pair<uint32_t, uint32_t>> cells;
+        std::vector<int64_t> values;
+        size_t total = 0;
+        for(const auto& adj: _adj_list) total += adj.size();
+        cells.reserve(total);
+        values.reserve(total);
+        for(uint32_t v = 0; v < _sz; v++){
+            for(const auto& [u, i]: _adj_list[v]){
+                cells.emplace_back(v, u);
+                values.push_back(_weights.empty() ? 1 : _weights[i]);
             }
         }
-        uint32_t big = static_cast<uint32_t>(masks.size()) - 1;
-        for(uint32_t v = 0; v + 1 < _sz; v++){
-            uint32_t mask = big ^ (1 << v);
-            if(masks[mask][v].has_value() && adj_mat[v][_sz - 1].has_value()){
-                std::vector<uint32_t> path;
-                path.push_back(_sz - 1);
-                while(v != _sz - 1){
-                    path.push_back(v);
-                    auto [nmask, nv] = *masks[mask][v];
-                    mask = nmask;
-                    v = nv;
-                }
-                return path;
-            }
-        }
-        return std::nullopt;
+        return SparseMatrix(_sz, cells, values);
     }
 
-
     std::optional<std::vector<uint32_t>> Graph::findEulerianCircuit(){
-        std::vector<uint32_t> deg(_sz);
+        // undirected graphs need even degrees, directed ones need equal in and out degrees
+        std::vector<int64_t> balance(_sz);
         for(const auto& [x, y]: _edges){
-            deg[x] ^= 1;
-            deg[y] ^= 1;
+            if(_is_directed){
+                balance[x]++;
+                balance[y]--;
+            }
+            else{
+                balance[x] ^= 1;
+                balance[y] ^= 1;
+            }
         }
-        std::optional<std::vector<uint32_t>> path;
-        if(std::count(deg.begin(), deg.end(), 1)){
+        if(std::count(balance.begin(), balance.end(), 0) != static_cast<ptrdiff_t>(_sz)){
             return std::nullopt;
         }
-        path = std::vector<uint32_t>();
-        std::vector<char> used_edges(_edges.size());
-        std::vector<uint32_t> adj_indexes(_sz);
 
-        auto dfs = [this, &path, &used_edges, &adj_indexes](auto& self, uint32_t v) -> void {
-            for(; adj_indexes[v] < _adj_list[v].size(); adj_indexes[v]++){
-                auto [u, ind] = _adj_list[v][adj_indexes[v]];
-                if(used_edges[ind]) continue;
-                used_edges[ind] = 1;
-                self(self, u);
-            }
-            (*path).push_back(v);
-        };
-
-        dfs(dfs, 0);
+        std::vector<uint32_t> path;
+        path.reserve(_edges.size() + 1);
+        DfsCallbacks callbacks;
+        callbacks.postorder = [&path](uint32_t v, uint32_t) { path.push_back(v); };
+        runDepthFirstSearch(_edges.empty() ? 0 : _edges[0].first, callbacks, true);
+        // edges in several components can't be walked in one circuit
+        if(path.size() != _edges.size() + 1) return std::nullopt;
+        // nodes are finished in the reverse order of the walk
+        std::reverse(path.begin(), path.end());
         return path;
     }
-
-
-    std::vector<uint32_t> Graph::findMinimumSpanningTree(){
-        std::priority_queue<std::pair<int32_t, uint32_t>, std::vector<std::pair<int32_t, uint32_t>>, std::greater<>> pq;
-        std::vector<char> in_tree(_sz);
-        std::vector<uint32_t> MST;
-        in_tree[0] = 1;
-        for(auto [s, j]: _adj_list[0]){
-            pq.push({_weights.empty() ? 1 : _weights[j], j});
-        }
-        while(!pq.empty()){
-            auto [w, ind] = pq.top();
-            pq.pop();
-            auto [u, v] = _edges[ind];
-            if(in_tree[u] > in_tree[v]) std::swap(u, v);
-            if(in_tree[u]) continue;
-            in_tree[u] = 1;
-            MST.push_back(ind);
-            for(auto [s, j]: _adj_list[u]){
-                if(in_tree[s]) continue;
-                pq.push({_weights.empty() ? 1 : _weights[j], j});
-            }
-        }
-        return MST;
-    }
-
 };
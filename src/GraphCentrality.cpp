@@ -0,0 +1,206 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace debug {
+    namespace {
+        // sum of values[columns[j]] for j in [0, count). The scalar version keeps four sums, so the additions don't wait for each other
+        double gatherSum(const double* values, const uint32_t* columns, size_t count) {
+            size_t j = 0;
+#if defined(__AVX2__)
+            __m256d acc = _mm256_setzero_pd();
+            // the masked form with an explicit source, _mm256_i32gather_pd reads an undefined one and trips -Wmaybe-uninitialized
+            const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            for(; j + 4 <= count; j += 4){
+                __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + j));
+                acc = _mm256_add_pd(acc, _mm256_mask_i32gather_pd(_mm256_setzero_pd(), values, indices, all_lanes, 8));
+            }
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, acc);
+            double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+            double sums[4] = {0, 0, 0, 0};
+            for(; j + 4 <= count; j += 4){
+                for(size_t k = 0; k < 4; k++) sums[k] += values[columns[j + k]];
+            }
+            double sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#endif
+            for(; j < count; j++) sum += values[columns[j]];
+            return sum;
+        }
+    }
+
+    std::optional<std::vector<double>> Graph::findBetweennessCentrality(uint32_t sample_count, uint64_t seed){
+        if(!_weights.empty() && getWeightRange().first <= 0) return std::nullopt;
+        std::vector<uint32_t> sources(_sz);
+        std::iota(sources.begin(), sources.end(), 0);
+        double scale = _is_directed ? 1.0 : 0.5; // undirected paths are found from both ends
+        if(sample_count > 0 && sample_count < _sz){
+            // the first sample_count positions of a partial Fisher-Yates shuffle
+            std::mt19937_64 rng(seed);
+            for(uint32_t j = 0; j < sample_count; j++){
+                std::uniform_int_distribution<uint32_t> pick(j, _sz - 1);
+                std::swap(sources[j], sources[pick(rng)]);
+            }
+            sources.resize(sample_count);
+            scale *= static_cast<double>(_sz) / sample_count;
+        }
+
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        bool weighted = !_weights.empty();
+        auto weight = [&](uint32_t i) { return weighted ? _weights[i] : 1; };
+
+        // one part per thread, every part has its own accumulator and takes sources from the shared counter
+        size_t parts = std::min<size_t>(getThreadCount(), sources.size());
+        std::vector<std::vector<double>> partial(parts);
+        std::atomic<size_t> next_source(0);
+        parallelFor(0, parts, [&](size_t part) {
+            auto& centrality = partial[part];
+            centrality.assign(_sz, 0);
+            std::vector<int64_t> dist(_sz, unreachable_distance);
+            std::vector<double> sigma(_sz, 0), delta(_sz, 0);
+            // nodes in the order they were settled, which is non-decreasing distance
+            std::vector<uint32_t> order;
+            using Item = std::pair<int64_t, uint32_t>;
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+
+            for(size_t j = next_source++; j < sources.size(); j = next_source++){
+                uint32_t s = sources[j];
+                order.clear();
+                dist[s] = 0;
+                sigma[s] = 1;
+                if(!weighted){
+                    order.push_back(s);
+                    for(size_t head = 0; head < order.size(); head++){
+                        uint32_t v = order[head];
+                        for(const auto& [u, i]: _adj_list[v]){
+                            if(dist[u] == unreachable_distance){
+                                dist[u] = dist[v] + 1;
+                                order.push_back(u);
+                            }
+                            if(dist[u] == dist[v] + 1) sigma[u] += sigma[v];
+                        }
+                    }
+                }
+                else{
+                    // positive weights, so the path count of a node is final once it's popped
+                    heap.push({0, s});
+                    while(!heap.empty()){
+                        auto [c, v] = heap.top();
+                        heap.pop();
+                        if(c != dist[v]) continue;
+                        order.push_back(v);
+                        for(const auto& [u, i]: _adj_list[v]){
+                            int64_t nd = c + _weights[i];
+                            if(nd < dist[u]){
+                                dist[u] = nd;
+                                sigma[u] = sigma[v];
+                                heap.push({nd, u});
+                            }
+                            else if(nd == dist[u]){
+                                sigma[u] += sigma[v];
+                            }
+                        }
+                    }
+                }
+
+                // dependencies flow back along the incoming edges which lie on shortest paths, no predecessor lists needed
+                for(auto it = order.rbegin(); it != order.rend(); ++it){
+                    uint32_t w = *it;
+                    double coefficient = (1 + delta[w]) / sigma[w];
+                    for(const auto& [v, i]: reverse_adj_list[w]){
+                        if(dist[v] != unreachable_distance && dist[v] + weight(i) == dist[w]) delta[v] += sigma[v] * coefficient;
+                    }
+                    if(w != s) centrality[w] += delta[w];
+                }
+                for(uint32_t v: order){
+                    dist[v] = unreachable_distance;
+                    sigma[v] = 0;
+                    delta[v] = 0;
+                }
+            }
+        });
+
+        std::vector<double> res(_sz, 0);
+        for(const auto& centrality: partial){
+            for(uint32_t v = 0; v < _sz; v++) res[v] += centrality[v];
+        }
+        for(double& x: res) x *= scale;
+        return res;
+    }
+
+    PageRankResult Graph::findPageRank(const PageRankOptions& options){
+        PageRankResult res;
+        double damping = options.damping;
+        std::vector<double> teleport(_sz, 1.0 / _sz);
+        double personalization_sum = 0;
+        for(size_t v = 0; v < std::min<size_t>(_sz, options.personalization.size()); v++) personalization_sum += options.personalization[v];
+        if(personalization_sum > 0){
+            for(uint32_t v = 0; v < _sz; v++) teleport[v] = v < options.personalization.size() ? options.personalization[v] / personalization_sum : 0;
+        }
+
+        // row v holds the sources of the edges coming into v
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        std::vector<size_t> offsets(_sz + 1, 0);
+        for(uint32_t v = 0; v < _sz; v++) offsets[v + 1] = offsets[v] + reverse_adj_list[v].size();
+        std::vector<uint32_t> columns(offsets.back());
+        std::vector<double> inverse_degree(_sz);
+        parallelFor(0, _sz, [&](size_t v) {
+            size_t j = offsets[v];
+            for(const auto& [u, i]: reverse_adj_list[v]) columns[j++] = u;
+            inverse_degree[v] = _adj_list[v].empty() ? 0 : 1.0 / static_cast<double>(_adj_list[v].size());
+        }, 1024);
+
+        // parts are ranges of rows with about the same number of edges, small graphs aren't worth starting threads
+        size_t work = offsets.back() + _sz;
+        size_t parts = work < 65536 ? 1 : 4 * static_cast<size_t>(getThreadCount());
+        std::vector<uint32_t> boundaries(parts + 1, _sz);
+        for(size_t part = 0; part < parts; part++){
+            size_t target = offsets.back() * part / parts;
+            boundaries[part] = static_cast<uint32_t>(std::lower_bound(offsets.begin(), offsets.end() - 1, target) - offsets.begin());
+        }
+
+        std::vector<double> rank = teleport, next(_sz), contribution(_sz), part_dangling(parts), part_change(parts);
+        for(uint32_t iteration = 0; iteration < options.max_iterations; iteration++){
+            // every node hands its rank out evenly over its outgoing edges, ranks of the nodes without them are spread like the jumps
+            parallelFor(0, parts, [&](size_t part) {
+                double dangling = 0;
+                for(uint32_t v = boundaries[part]; v < boundaries[part + 1]; v++){
+                    contribution[v] = rank[v] * inverse_degree[v];
+                    if(_adj_list[v].empty()) dangling += rank[v];
+                }
+                part_dangling[part] = dangling;
+            });
+            double dangling = std::accumulate(part_dangling.begin(), part_dangling.end(), 0.0);
+
+            parallelFor(0, parts, [&](size_t part) {
+                double change = 0;
+                for(uint32_t v = boundaries[part]; v < boundaries[part + 1]; v++){
+                    double incoming = gatherSum(contribution.data(), columns.data() + offsets[v], offsets[v + 1] - offsets[v]);
+                    next[v] = (1 - damping + damping * dangling) * teleport[v] + damping * incoming;
+                    change += std::abs(next[v] - rank[v]);
+                }
+                part_change[part] = change;
+            });
+            rank.swap(next);
+            res.iterations = iteration + 1;
+            if(std::accumulate(part_change.begin(), part_change.end(), 0.0) < options.tolerance){
+                res.is_converged = true;
+                break;
+            }
+        }
+        res.ranks = std::move(rank);
+        return res;
+    }
+};
@@ -0,0 +1,325 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    std::vector<uint32_t> Graph::findStronglyConnectedComponents(){
+        std::vector<uint32_t> component(_sz, no_parent);
+        uint32_t count = 0;
+        if(!_is_directed){
+            std::vector<uint32_t> queue;
+            for(uint32_t root = 0; root < _sz; root++){
+                if(component[root] != no_parent) continue;
+                component[root] = count;
+                queue.assign(1, root);
+                for(size_t head = 0; head < queue.size(); head++){
+                    for(const auto& [u, i]: _adj_list[queue[head]]){
+                        if(component[u] != no_parent) continue;
+                        component[u] = count;
+                        queue.push_back(u);
+                    }
+                }
+                count++;
+            }
+            return component;
+        }
+
+        // Tarjan's algorithm over the DFS engine, nodes stay on the stack until their component is complete
+        std::vector<uint32_t> index(_sz), low(_sz), stack;
+        std::vector<char> on_stack(_sz);
+        uint32_t timer = 0;
+        DfsCallbacks callbacks;
+        callbacks.preorder = [&](uint32_t v, uint32_t) {
+            index[v] = low[v] = timer++;
+            stack.push_back(v);
+            on_stack[v] = 1;
+        };
+        callbacks.edge = [&](uint32_t v, uint32_t u, uint32_t, DfsEdgeType type) {
+            if(type != DfsEdgeType::tree && on_stack[u]) low[v] = std::min(low[v], index[u]);
+        };
+        callbacks.postorder = [&](uint32_t v, uint32_t parent_edge) {
+            if(low[v] == index[v]){
+                uint32_t u;
+                do{
+                    u = stack.back();
+                    stack.pop_back();
+                    on_stack[u] = 0;
+                    component[u] = count;
+                } while(u != v);
+                count++;
+            }
+            if(parent_edge != no_parent){
+                uint32_t p = _edges[parent_edge].first;
+                low[p] = std::min(low[p], low[v]);
+            }
+        };
+        runDepthFirstSearch(std::nullopt, callbacks, false);
+
+        // Tarjan's algorithm finishes components in reverse topological order
+        for(auto& c: component) c = count - 1 - c;
+        return component;
+    }
+
+    Graph Graph::getCondensation(){
+        auto component = findStronglyConnectedComponents();
+        uint32_t count = component.empty() ? 0 : *std::max_element(component.begin(), component.end()) + 1;
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        for(const auto& [x, y]: _edges){
+            if(component[x] != component[y]) edges.emplace_back(component[x], component[y]);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        Builder builder(count, _is_directed);
+        builder.addEdges(edges.begin(), edges.end());
+        return Graph(std::move(builder));
+    }
+
+    std::vector<uint32_t> Graph::findConnectedComponentsParallel(){
+        // the first neighbours of every node are linked in rounds, they usually connect most of the biggest component
+        const uint32_t neighbour_rounds = 2, sample_size = 1024;
+        std::vector<std::atomic<uint32_t>> parent(_sz);
+        parallelFor(0, _sz, [&](size_t v) { parent[v].store(static_cast<uint32_t>(v), std::memory_order_relaxed); }, 4096);
+
+        // the bigger root is hooked under the smaller one, so every root is the smallest node of its tree
+        auto link = [&parent](uint32_t u, uint32_t v) {
+            uint32_t p1 = parent[u].load(std::memory_order_relaxed), p2 = parent[v].load(std::memory_order_relaxed);
+            while(p1 != p2){
+                uint32_t high = std::max(p1, p2), low = std::min(p1, p2);
+                uint32_t p_high = parent[high].load(std::memory_order_relaxed);
+                if(p_high == low) break;
+                if(p_high == high && parent[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed)) break;
+                p1 = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+                p2 = parent[low].load(std::memory_order_relaxed);
+            }
+        };
+        auto compress = [&parent, this]() {
+            parallelFor(0, _sz, [&](size_t v) {
+                uint32_t p = parent[v].load(std::memory_order_relaxed);
+                while(p != parent[p].load(std::memory_order_relaxed)) p = parent[p].load(std::memory_order_relaxed);
+                parent[v].store(p, std::memory_order_relaxed);
+            }, 4096);
+        };
+
+        for(uint32_t round = 0; round < neighbour_rounds; round++){
+            parallelFor(0, _sz, [&](size_t v) {
+                if(round < _adj_list[v].size()) link(static_cast<uint32_t>(v), _adj_list[v][round].first);
+            }, 4096);
+            compress();
+        }
+
+        // in undirected graphs every edge is in both adjacency lists, so the nodes of the biggest component can be skipped,
+        // their edges to other components are linked from the other side
+        uint32_t skipped = no_parent;
+        if(!_is_directed){
+            std::mt19937 rng(_sz);
+            std::vector<uint32_t> sample(sample_size);
+            for(auto& x: sample) x = parent[rng() % _sz].load(std::memory_order_relaxed);
+            std::sort(sample.begin(), sample.end());
+            size_t best = 0;
+            for(size_t i = 0, j = 0; i < sample.size(); i = j){
+                while(j < sample.size() && sample[j] == sample[i]) j++;
+                if(j - i > best){
+                    best = j - i;
+                    skipped = sample[i];
+                }
+            }
+        }
+        parallelFor(0, _sz, [&](size_t v) {
+            if(parent[v].load(std::memory_order_relaxed) == skipped) return;
+            for(size_t j = neighbour_rounds; j < _adj_list[v].size(); j++) link(static_cast<uint32_t>(v), _adj_list[v][j].first);
+        }, 1024);
+        compress();
+
+        // roots are the smallest nodes, so numbering them in the order of appearance gives the same ids as the BFS labeling
+        std::vector<uint32_t> component(_sz);
+        uint32_t count = 0;
+        for(uint32_t v = 0; v < _sz; v++){
+            uint32_t p = parent[v].load(std::memory_order_relaxed);
+            component[v] = p == v ? count++ : component[p];
+        }
+        return component;
+    }
+
+    BiconnectedComponents Graph::findBiconnectedComponents(){
+        BiconnectedComponents res;
+        res.edge_blocks.assign(_edges.size(), no_parent);
+        // directed graphs also walk incoming edges, undirected ones have every edge in both lists already
+        const auto& adj_list = _adj_list;
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        auto degree = [&](uint32_t v) { return adj_list[v].size() + (_is_directed ? reverse_adj_list[v].size() : 0); };
+        auto neighbour = [&](uint32_t v, size_t j) { return j < adj_list[v].size() ? adj_list[v][j] : reverse_adj_list[v][j - adj_list[v].size()]; };
+
+        struct Frame{
+            uint32_t node;
+            uint32_t parent_edge;
+            size_t next;
+        };
+        std::vector<Frame> stack;
+        std::vector<uint32_t> tin(_sz, no_parent), low(_sz), edge_stack;
+        std::vector<char> is_articulation_point(_sz);
+        uint32_t timer = 0;
+        for(uint32_t root = 0; root < _sz; root++){
+            if(tin[root] != no_parent) continue;
+            tin[root] = low[root] = timer++;
+            stack.push_back({root, no_parent, 0});
+            uint32_t root_children = 0;
+            while(!stack.empty()){
+                Frame& frame = stack.back();
+                uint32_t v = frame.node;
+                if(frame.next < degree(v)){
+                    auto [u, i] = neighbour(v, frame.next++);
+                    // only the tree edge itself is skipped, a parallel edge to the parent is a back edge
+                    if(i == frame.parent_edge || u == v) continue;
+                    if(tin[u] == no_parent){
+                        edge_stack.push_back(i);
+                        tin[u] = low[u] = timer++;
+                        if(v == root) root_children++;
+                        stack.push_back({u, i, 0});
+                    }
+                    else if(tin[u] < tin[v]){
+                        low[v] = std::min(low[v], tin[u]);
+                        edge_stack.push_back(i);
+                    }
+                    // tin[u] > tin[v] is the other end of a back edge, it's pushed already
+                    continue;
+                }
+
+                uint32_t parent_edge = frame.parent_edge;
+                stack.pop_back();
+                if(parent_edge == no_parent) continue;
+                uint32_t p = stack.back().node;
+                low[p] = std::min(low[p], low[v]);
+                if(low[v] > tin[p]) res.bridges.push_back(parent_edge);
+                if(low[v] >= tin[p]){
+                    // p separates the subtree of v, everything pushed since the edge p - v is one block
+                    if(p != root) is_articulation_point[p] = 1;
+                    uint32_t e;
+                    do{
+                        e = edge_stack.back();
+                        edge_stack.pop_back();
+                        res.edge_blocks[e] = res.block_count;
+                    } while(e != parent_edge);
+                    res.block_count++;
+                }
+            }
+            if(root_children > 1) is_articulation_point[root] = 1;
+        }
+
+        std::vector<uint32_t> tree_index(_sz, no_parent);
+        for(uint32_t v = 0; v < _sz; v++){
+            if(!is_articulation_point[v]) continue;
+            tree_index[v] = res.block_count + static_cast<uint32_t>(res.articulation_points.size());
+            res.articulation_points.push_back(v);
+        }
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            uint32_t block = res.edge_blocks[i];
+            if(block == no_parent) continue;
+            for(uint32_t x: {_edges[i].first, _edges[i].second}){
+                if(tree_index[x] != no_parent) res.block_cut_tree.emplace_back(block, tree_index[x]);
+            }
+        }
+        std::sort(res.block_cut_tree.begin(), res.block_cut_tree.end());
+        res.block_cut_tree.erase(std::unique(res.block_cut_tree.begin(), res.block_cut_tree.end()), res.block_cut_tree.end());
+        return res;
+    }
+
+    CoreDecomposition Graph::findCoreDecomposition(){
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        // neighbours of v are its outgoing and, for directed graphs, incoming edges
+        auto forEachNeighbour = [&](uint32_t v, auto&& f) {
+            for(const auto& [u, i]: _adj_list[v]){
+                if(u != v) f(u);
+            }
+            if(!_is_directed) return;
+            for(const auto& [u, i]: reverse_adj_list[v]){
+                if(u != v) f(u);
+            }
+        };
+
+        CoreDecomposition res;
+        auto& degree = res.core_numbers;
+        degree.assign(_sz, 0);
+        uint32_t max_degree = 0;
+        for(uint32_t v = 0; v < _sz; v++){
+            forEachNeighbour(v, [&](uint32_t) { degree[v]++; });
+            max_degree = std::max(max_degree, degree[v]);
+        }
+
+        // nodes sorted by degree, bucket d starts at bin[d]. A node whose degree drops swaps with the first node of its bucket,
+        // which then starts one position later
+        std::vector<uint32_t> bin(max_degree + 2, 0), position(_sz);
+        auto& order = res.degeneracy_order;
+        order.resize(_sz);
+        for(uint32_t v = 0; v < _sz; v++) bin[degree[v] + 1]++;
+        for(uint32_t d = 0; d <= max_degree; d++) bin[d + 1] += bin[d];
+        for(uint32_t v = 0; v < _sz; v++){
+            position[v] = bin[degree[v]]++;
+            order[position[v]] = v;
+        }
+        for(uint32_t d = max_degree + 1; d > 0; d--) bin[d] = bin[d - 1];
+        bin[0] = 0;
+
+        for(uint32_t j = 0; j < _sz; j++){
+            uint32_t v = order[j];
+            forEachNeighbour(v, [&](uint32_t u) {
+                if(degree[u] <= degree[v]) return;
+                uint32_t first = bin[degree[u]], w = order[first];
+                if(u != w){
+                    std::swap(order[position[u]], order[first]);
+                    std::swap(position[u], position[w]);
+                }
+                bin[degree[u]]++;
+                degree[u]--;
+            });
+        }
+        // peeled nodes keep their degree at the moment they were removed, which is the core number
+        res.degeneracy = _sz ? *std::max_element(degree.begin(), degree.end()) : 0;
+        return res;
+    }
+
+    Graph Graph::buildCore(const std::vector<uint32_t>& core_numbers, uint32_t k) const {
+        std::vector<uint32_t> index(_sz, no_parent);
+        uint32_t count = 0;
+        for(uint32_t v = 0; v < _sz; v++){
+            if(core_numbers[v] >= k) index[v] = count++;
+        }
+        Builder builder(count, _is_directed);
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            auto [x, y] = _edges[i];
+            if(index[x] == no_parent || index[y] == no_parent) continue;
+            if(_weights.empty()) builder.addEdge(index[x], index[y]);
+            else builder.addEdge(index[x], index[y], _weights[i]);
+        }
+        return Graph(std::move(builder));
+    }
+
+    Graph Graph::getCore(uint32_t k){
+        return buildCore(findCoreDecomposition().core_numbers, k);
+    }
+
+    void Graph::visualizeCore(uint32_t k){
+        auto cores = findCoreDecomposition();
+        std::vector<double> core_numbers;
+        std::vector<std::string> labels;
+        for(uint32_t v = 0; v < _sz; v++){
+            if(cores.core_numbers[v] < k) continue;
+            core_numbers.push_back(cores.core_numbers[v]);
+            labels.push_back(std::to_string(v));
+        }
+        if(labels.empty()) return;
+
+        Graph core = buildCore(cores.core_numbers, k);
+        core.visualize(getValueColors(core_numbers), {}, {}, {}, labels);
+        // the tab outlives the core, but if the core has just opened the window, this graph waits for it to close instead.
+        // A new window means that the one of this graph's thread is closed, so that thread is finishing
+        if(core._running_thread.joinable()){
+            if(_running_thread.joinable()) _running_thread.join();
+            _running_thread = std::move(core._running_thread);
+        }
+    }
+};
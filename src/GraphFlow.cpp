@@ -0,0 +1,251 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    namespace {
+        /*
+        Residual graph in CSR form: arcs of the node v are [offsets[v], offsets[v + 1]), every arc knows its reverse arc.
+        The edge i is the arc edge_arc[i] from its first node to the second one, its reverse arc has the capacity of 0 for directed edges.
+        */
+        struct ResidualNetwork{
+            uint32_t node_count;
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> head;
+            std::vector<uint32_t> reverse;
+            std::vector<int64_t> capacity;
+            std::vector<int64_t> initial_capacity;
+            std::vector<uint32_t> edge_arc;
+        };
+
+        const uint32_t unreachable = std::numeric_limits<uint32_t>::max();
+
+        // distances to the sink over the residual arcs (found from the sink along the reverse arcs), unreachable if there's no path
+        void findDistancesToSink(const ResidualNetwork& network, uint32_t sink, std::vector<uint32_t>& dist, std::vector<uint32_t>& queue) {
+            dist.assign(network.node_count, unreachable);
+            dist[sink] = 0;
+            queue.assign(1, sink);
+            for(size_t head = 0; head < queue.size(); head++){
+                uint32_t w = queue[head];
+                for(uint32_t a = network.offsets[w]; a < network.offsets[w + 1]; a++){
+                    uint32_t x = network.head[a];
+                    if(dist[x] != unreachable || network.capacity[network.reverse[a]] <= 0) continue;
+                    dist[x] = dist[w] + 1;
+                    queue.push_back(x);
+                }
+            }
+        }
+
+        int64_t runDinic(ResidualNetwork& network, uint32_t source, uint32_t sink) {
+            uint32_t n = network.node_count;
+            std::vector<uint32_t> level, queue, current(n), path;
+            int64_t flow = 0;
+            while(true){
+                // levels are distances to the sink, so the blocking flow goes along decreasing levels and the dead ends are cut off early
+                findDistancesToSink(network, sink, level, queue);
+                if(level[source] == unreachable) break;
+                std::copy(network.offsets.begin(), network.offsets.end() - 1, current.begin());
+
+                // iterative DFS, path holds the arcs from the source to v
+                uint32_t v = source;
+                path.clear();
+                while(true){
+                    if(v == sink){
+                        int64_t pushed = std::numeric_limits<int64_t>::max();
+                        for(uint32_t a: path) pushed = std::min(pushed, network.capacity[a]);
+                        size_t first_saturated = path.size();
+                        for(size_t j = 0; j < path.size(); j++){
+                            network.capacity[path[j]] -= pushed;
+                            network.capacity[network.reverse[path[j]]] += pushed;
+                            if(network.capacity[path[j]] == 0 && first_saturated == path.size()) first_saturated = j;
+                        }
+                        flow += pushed;
+                        // the search goes on from the tail of the first saturated arc
+                        path.resize(first_saturated);
+                        v = path.empty() ? source : network.head[path.back()];
+                        continue;
+                    }
+
+                    uint32_t& a = current[v];
+                    while(a < network.offsets[v + 1] && (network.capacity[a] <= 0 || level[network.head[a]] + 1 != level[v])) a++;
+                    if(a < network.offsets[v + 1]){
+                        path.push_back(a);
+                        v = network.head[a];
+                        continue;
+                    }
+
+                    // nothing leads to the sink from v anymore
+                    level[v] = unreachable;
+                    if(v == source) break;
+                    path.pop_back();
+                    v = path.empty() ? source : network.head[path.back()];
+                    current[v]++;
+                }
+            }
+            return flow;
+        }
+
+        int64_t runPushRelabel(ResidualNetwork& network, uint32_t source, uint32_t sink) {
+            uint32_t n = network.node_count;
+            // heights below n are distances to the sink, from n up they are n + distance to the source, the excess of such nodes goes back
+            uint32_t max_height = 2 * n;
+            std::vector<uint32_t> height(n), current(n), count(max_height + 1), queue, dist;
+            std::vector<int64_t> excess(n);
+            std::vector<std::vector<uint32_t>> buckets(max_height + 1);
+            uint32_t highest = 0;
+
+            auto activate = [&](uint32_t v) {
+                if(v == source || v == sink || height[v] >= max_height) return;
+                buckets[height[v]].push_back(v);
+                highest = std::max(highest, height[v]);
+            };
+
+            auto globalRelabel = [&]() {
+                findDistancesToSink(network, sink, dist, queue);
+                for(uint32_t v = 0; v < n; v++) height[v] = dist[v] == unreachable ? max_height : dist[v];
+                // nodes which can't reach the sink are measured from the source
+                height[source] = n;
+                queue.assign(1, source);
+                for(size_t head = 0; head < queue.size(); head++){
+                    uint32_t w = queue[head];
+                    for(uint32_t a = network.offsets[w]; a < network.offsets[w + 1]; a++){
+                        uint32_t x = network.head[a];
+                        if(height[x] != max_height || network.capacity[network.reverse[a]] <= 0) continue;
+                        height[x] = height[w] + 1;
+                        queue.push_back(x);
+                    }
+                }
+                std::fill(count.begin(), count.end(), 0);
+                for(auto& bucket: buckets) bucket.clear();
+                highest = 0;
+                for(uint32_t v = 0; v < n; v++){
+                    count[height[v]]++;
+                    current[v] = network.offsets[v];
+                    if(excess[v] > 0) activate(v);
+                }
+            };
+
+            auto push = [&](uint32_t v, uint32_t a) {
+                uint32_t w = network.head[a];
+                int64_t pushed = std::min(excess[v], network.capacity[a]);
+                network.capacity[a] -= pushed;
+                network.capacity[network.reverse[a]] += pushed;
+                excess[v] -= pushed;
+                excess[w] += pushed;
+                if(excess[w] == pushed) activate(w);
+            };
+
+            // if no node is left at some height below n, nodes above it can't reach the sink anymore
+            auto gap = [&](uint32_t empty_height) {
+                for(uint32_t v = 0; v < n; v++){
+                    if(height[v] <= empty_height || height[v] >= n || v == source) continue;
+                    count[height[v]]--;
+                    height[v] = n + 1;
+                    count[height[v]]++;
+                    current[v] = network.offsets[v];
+                    if(excess[v] > 0) activate(v);
+                }
+            };
+
+            for(uint32_t a = network.offsets[source]; a < network.offsets[source + 1]; a++){
+                excess[source] += network.capacity[a];
+            }
+            for(uint32_t a = network.offsets[source]; a < network.offsets[source + 1]; a++){
+                if(network.capacity[a] > 0) push(source, a);
+            }
+            globalRelabel();
+
+            uint64_t relabels = 0;
+            while(true){
+                while(highest > 0 && buckets[highest].empty()) highest--;
+                if(buckets[highest].empty()) break;
+                uint32_t v = buckets[highest].back();
+                buckets[highest].pop_back();
+                if(height[v] != highest || excess[v] == 0) continue;
+
+                // discharge
+                while(excess[v] > 0 && height[v] < max_height){
+                    uint32_t& a = current[v];
+                    if(a == network.offsets[v + 1]){
+                        uint32_t old_height = height[v], new_height = max_height;
+                        for(uint32_t b = network.offsets[v]; b < network.offsets[v + 1]; b++){
+                            if(network.capacity[b] > 0) new_height = std::min(new_height, height[network.head[b]] + 1);
+                        }
+                        count[old_height]--;
+                        height[v] = new_height;
+                        count[new_height]++;
+                        a = network.offsets[v];
+                        relabels++;
+                        if(count[old_height] == 0 && old_height < n) gap(old_height);
+                        continue;
+                    }
+                    uint32_t w = network.head[a];
+                    if(network.capacity[a] > 0 && height[v] == height[w] + 1) push(v, a);
+                    else a++;
+                }
+
+                if(relabels >= n){
+                    relabels = 0;
+                    globalRelabel();
+                }
+            }
+            return excess[sink];
+        }
+    }
+
+    MaxFlow Graph::findMaxFlow(uint32_t source, uint32_t sink, MaxFlowAlgorithm algorithm){
+        MaxFlow res;
+        res.edge_flows.assign(_edges.size(), 0);
+        res.source_side.assign(_sz, 0);
+        res.source_side[source] = 1;
+        if(source == sink) return res;
+
+        ResidualNetwork network;
+        network.node_count = _sz;
+        network.offsets.assign(_sz + 1, 0);
+        for(const auto& [u, v]: _edges){
+            network.offsets[u + 1]++;
+            network.offsets[v + 1]++;
+        }
+        for(uint32_t v = 0; v < _sz; v++) network.offsets[v + 1] += network.offsets[v];
+        size_t arc_count = 2 * _edges.size();
+        network.head.resize(arc_count);
+        network.reverse.resize(arc_count);
+        network.capacity.resize(arc_count);
+        network.edge_arc.resize(_edges.size());
+        std::vector<uint32_t> position(network.offsets.begin(), network.offsets.end() - 1);
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            auto [u, v] = _edges[i];
+            int64_t c = _weights.empty() ? 1 : std::max<int64_t>(_weights[i], 0);
+            uint32_t forward = position[u]++, backward = position[v]++;
+            network.head[forward] = v;
+            network.head[backward] = u;
+            network.reverse[forward] = backward;
+            network.reverse[backward] = forward;
+            network.capacity[forward] = c;
+            network.capacity[backward] = _is_directed ? 0 : c;
+            network.edge_arc[i] = forward;
+        }
+        network.initial_capacity = network.capacity;
+
+        res.value = algorithm == MaxFlowAlgorithm::dinic ? runDinic(network, source, sink) : runPushRelabel(network, source, sink);
+
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            uint32_t a = network.edge_arc[i];
+            res.edge_flows[i] = network.initial_capacity[a] - network.capacity[a];
+        }
+        std::vector<uint32_t> queue = {source};
+        for(size_t head = 0; head < queue.size(); head++){
+            uint32_t w = queue[head];
+            for(uint32_t a = network.offsets[w]; a < network.offsets[w + 1]; a++){
+                uint32_t x = network.head[a];
+                if(res.source_side[x] || network.capacity[a] <= 0) continue;
+                res.source_side[x] = 1;
+                queue.push_back(x);
+            }
+        }
+        return res;
+    }
+};
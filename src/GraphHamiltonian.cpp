@@ -0,0 +1,289 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    class Graph::HamiltonianSearch{
+        const Graph& _graph;
+        const HamiltonianSearchOptions& _options;
+        std::thread::id _caller;
+        std::optional<std::chrono::steady_clock::time_point> _deadline;
+        std::chrono::steady_clock::time_point _last_report;
+        std::atomic<bool> _is_stopped;
+        std::atomic<uint64_t> _done;
+        uint64_t _total;
+
+        template<typename F>
+        void forEach(size_t count, F&& f) {
+            if(_options.parallel) parallelFor(0, count, f);
+            else for(size_t i = 0; i < count; i++) f(i);
+        }
+
+        // counts work done and checks the time budget, the progress callback is called from the calling thread only
+        void poll(uint64_t work) {
+            _done.fetch_add(work, std::memory_order_relaxed);
+            if(isStopped()) return;
+            auto now = std::chrono::steady_clock::now();
+            if(_deadline.has_value() && now >= *_deadline){
+                _is_stopped = true;
+                return;
+            }
+            if(_options.progress && std::this_thread::get_id() == _caller && now - _last_report >= std::chrono::milliseconds(50)){
+                _last_report = now;
+                double part = static_cast<double>(_done.load(std::memory_order_relaxed)) / static_cast<double>(std::max<uint64_t>(_total, 1));
+                if(!_options.progress(std::min(part, 1.0))) _is_stopped = true;
+            }
+        }
+
+    public:
+        HamiltonianSearch(const Graph& graph, const HamiltonianSearchOptions& options):
+            _graph(graph),
+            _options(options),
+            _caller(std::this_thread::get_id()),
+            _deadline(std::nullopt),
+            _last_report(std::chrono::steady_clock::now()),
+            _is_stopped(false),
+            _done(0),
+            _total(1)
+            {
+                if(options.time_budget.count() > 0) _deadline = _last_report + options.time_budget;
+            }
+
+        bool isStopped() const {
+            return _is_stopped.load(std::memory_order_relaxed);
+        }
+
+        bool failsNecessaryConditions() const {
+            uint32_t n = _graph._sz;
+            const auto& adj_list = _graph._adj_list;
+            const auto& reverse_adj_list = _graph.getReverseAdjacencyList();
+
+            // every node needs edges to 2 other nodes, or an edge in and an edge out if the graph is directed
+            for(uint32_t v = 0; v < n; v++){
+                // adjacency lists aren't sorted after addEdge/removeEdge, but two distinct neighbours are all we look for
+                uint32_t neighbours = 0, first = v;
+                for(const auto& [u, i]: adj_list[v]){
+                    if(u == v || u == first) continue;
+                    if(++neighbours == 2) break;
+                    first = u;
+                }
+                if(neighbours < (_graph._is_directed ? 1u : std::min(n - 1, 2u))) return true;
+                auto from_other = [v](const std::pair<uint32_t, uint32_t>& edge) { return edge.first != v; };
+                if(_graph._is_directed && std::none_of(reverse_adj_list[v].begin(), reverse_adj_list[v].end(), from_other)) return true;
+            }
+
+            // every node must be reachable from 0 and 0 must be reachable from every node
+            for(const auto* adj: {&adj_list, &reverse_adj_list}){
+                std::vector<char> used(n);
+                std::vector<uint32_t> queue = {0};
+                used[0] = 1;
+                for(size_t head = 0; head < queue.size(); head++){
+                    for(const auto& [u, i]: (*adj)[queue[head]]){
+                        if(used[u]) continue;
+                        used[u] = 1;
+                        queue.push_back(u);
+                    }
+                }
+                if(queue.size() != n) return true;
+                if(!_graph._is_directed) break;
+            }
+
+            // a cycle stays connected after removing any node, so there must be no articulation points
+            if(_graph._is_directed || n < 3) return false;
+            std::vector<uint32_t> tin(n), low(n);
+            uint32_t timer = 0, root_children = 0;
+            bool has_articulation_point = false;
+            DfsCallbacks callbacks;
+            callbacks.preorder = [&](uint32_t v, uint32_t) { tin[v] = low[v] = timer++; };
+            callbacks.edge = [&](uint32_t v, uint32_t u, uint32_t, DfsEdgeType type) {
+                if(type == DfsEdgeType::back) low[v] = std::min(low[v], tin[u]);
+            };
+            callbacks.postorder = [&](uint32_t v, uint32_t parent_edge) {
+                if(parent_edge == no_parent) return;
+                auto [x, y] = _graph._edges[parent_edge];
+                uint32_t p = x == v ? y : x;
+                low[p] = std::min(low[p], low[v]);
+                if(p == 0) root_children++;
+                else if(low[v] >= tin[p]) has_articulation_point = true;
+            };
+            _graph.runDepthFirstSearch(0, callbacks, false);
+            return has_articulation_point || root_children > 1;
+        }
+
+        std::optional<std::vector<uint32_t>> runDP() {
+            // paths start at the last node, the rest k nodes are bits of masks
+            uint32_t last = _graph._sz - 1, k = _graph._sz - 1;
+            // in_adj[u] has a bit v for every edge v -> u, from_last and to_last are the edges of the last node
+            std::vector<uint32_t> in_adj(k);
+            uint32_t from_last = 0, to_last = 0;
+            for(const auto& [x, y]: _graph._edges){
+                for(auto [u, v]: {std::make_pair(x, y), std::make_pair(y, x)}){
+                    if(u == last && v != last) from_last |= 1u << v;
+                    else if(v == last && u != last) to_last |= 1u << u;
+                    else if(u != last && v != last) in_adj[v] |= 1u << u;
+                    if(_graph._is_directed) break;
+                }
+            }
+
+            // dp[mask] is the set of possible ends of paths that start at the last node and visit exactly mask
+            std::vector<uint32_t> dp(size_t(1) << k);
+            for(uint32_t v = 0; v < k; v++){
+                if(from_last >> v & 1) dp[size_t(1) << v] = 1u << v;
+            }
+            _total = dp.size();
+
+            // masks with p bits depend only on masks with p - 1 bits, so every layer is split into chunks processed in parallel.
+            // Masks of a chunk go in increasing order, the first one is found from its rank among the masks of the layer
+            std::vector<std::vector<uint64_t>> binomial(k + 1, std::vector<uint64_t>(k + 1, 0));
+            for(uint32_t i = 0; i <= k; i++){
+                binomial[i][0] = 1;
+                for(uint32_t j = 1; j <= i; j++) binomial[i][j] = binomial[i - 1][j - 1] + (j < i ? binomial[i - 1][j] : 0);
+            }
+            const uint64_t chunk_size = 1 << 14;
+            for(uint32_t p = 2; p <= k && !isStopped(); p++){
+                uint64_t count = binomial[k][p];
+                forEach(static_cast<size_t>((count + chunk_size - 1) / chunk_size), [&](size_t chunk) {
+                    if(isStopped()) return;
+                    uint64_t first = chunk * chunk_size, last_rank = std::min(count, first + chunk_size);
+                    uint64_t mask = 0, rank = first;
+                    for(uint32_t i = p, bound = k; i > 0; i--){
+                        uint32_t x = bound - 1;
+                        while(binomial[x][i] > rank) x--;
+                        mask |= uint64_t(1) << x;
+                        rank -= binomial[x][i];
+                        bound = x;
+                    }
+                    for(uint64_t r = first; r < last_rank; r++){
+                        uint32_t ends = 0;
+                        for(uint64_t rest = mask; rest; rest &= rest - 1){
+                            uint32_t u = static_cast<uint32_t>(countTrailingZeros64(rest));
+                            if(dp[mask ^ (uint64_t(1) << u)] & in_adj[u]) ends |= 1u << u;
+                        }
+                        dp[mask] = ends;
+                        // the next mask with the same number of bits
+                        uint64_t t = mask | (mask - 1);
+                        mask = (t + 1) | (((~t & (t + 1)) - 1) >> (countTrailingZeros64(mask) + 1));
+                    }
+                    poll(last_rank - first);
+                });
+            }
+            if(isStopped()) return std::nullopt;
+
+            size_t mask = dp.size() - 1;
+            uint32_t ends = dp[mask] & to_last;
+            if(ends == 0) return std::nullopt;
+            // walking back from the end, every previous end is any bit of the smaller mask with an edge to the current one
+            std::vector<uint32_t> path;
+            uint32_t v = static_cast<uint32_t>(countTrailingZeros64(ends));
+            while(true){
+                path.push_back(v);
+                mask ^= size_t(1) << v;
+                if(mask == 0) break;
+                v = static_cast<uint32_t>(countTrailingZeros64(dp[mask] & in_adj[v]));
+            }
+            path.push_back(last);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        std::optional<std::vector<uint32_t>> runBacktracking() {
+            uint32_t n = _graph._sz, start = n - 1;
+            const auto& adj_list = _graph._adj_list;
+            std::vector<char> closes(n);
+            for(const auto& [u, i]: _graph.getReverseAdjacencyList()[start]) closes[u] = 1;
+
+            // every task is a path start -> a -> b, it's searched further by one thread
+            std::vector<std::pair<uint32_t, uint32_t>> prefixes;
+            for(const auto& [a, i]: adj_list[start]){
+                if(a == start || (prefixes.size() && prefixes.back().first == a)) continue;
+                for(const auto& [b, j]: adj_list[a]){
+                    if(b == start || b == a || (prefixes.size() && prefixes.back() == std::make_pair(a, b))) continue;
+                    prefixes.emplace_back(a, b);
+                }
+            }
+            _total = prefixes.size();
+
+            std::mutex result_mutex;
+            std::optional<std::vector<uint32_t>> result;
+            forEach(prefixes.size(), [&](size_t task) {
+                if(isStopped()) return;
+                auto [a, b] = prefixes[task];
+                std::vector<char> used(n);
+                used[start] = used[a] = used[b] = 1;
+                // unused nodes with an edge to start, when there are none left the path can't be closed
+                uint32_t closing = 0;
+                for(uint32_t v = 0; v < n; v++) closing += closes[v] && !used[v];
+
+                // candidates of every step are kept in one array, the ones with the fewest unused neighbours go first (Warnsdorff's rule)
+                std::vector<uint32_t> path = {start, a, b}, candidates, next_candidate;
+                std::vector<std::pair<uint32_t, uint32_t>> order;
+                auto pushCandidates = [&](uint32_t v) {
+                    order.clear();
+                    for(const auto& [u, i]: adj_list[v]){
+                        if(used[u] || (order.size() && order.back().second == u)) continue;
+                        uint32_t free_neighbours = 0;
+                        for(const auto& [w, j]: adj_list[u]) free_neighbours += !used[w];
+                        order.emplace_back(free_neighbours, u);
+                    }
+                    std::stable_sort(order.begin(), order.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+                    next_candidate.push_back(static_cast<uint32_t>(candidates.size()));
+                    for(auto it = order.rbegin(); it != order.rend(); it++) candidates.push_back(it->second);
+                };
+                next_candidate = {0, 0};
+                pushCandidates(b);
+
+                uint64_t steps = 0;
+                while(path.size() >= 3 && !isStopped()){
+                    if(++steps % 4096 == 0) poll(0);
+                    uint32_t v = path.back();
+                    if(path.size() == n && closes[v]){
+                        std::lock_guard lock(result_mutex);
+                        if(!result.has_value()) result = path;
+                        _is_stopped = true;
+                        break;
+                    }
+                    // candidates of the current step are candidates[next_candidate.back()..], taken from the back
+                    if(path.size() == n || closing == 0 || candidates.size() == next_candidate.back()){
+                        used[v] = 0;
+                        if(closes[v]) closing++;
+                        path.pop_back();
+                        candidates.resize(next_candidate.back());
+                        next_candidate.pop_back();
+                        continue;
+                    }
+                    uint32_t u = candidates.back();
+                    candidates.pop_back();
+                    if(used[u]) continue;
+                    used[u] = 1;
+                    if(closes[u]) closing--;
+                    path.push_back(u);
+                    pushCandidates(u);
+                }
+                poll(1);
+            });
+            return result;
+        }
+    };
+
+    std::optional<std::vector<uint32_t>> Graph::findHamiltonianCycle(){
+        return findHamiltonianCycle(HamiltonianSearchOptions()).cycle;
+    }
+
+    HamiltonianSearchResult Graph::findHamiltonianCycle(const HamiltonianSearchOptions& options){
+        HamiltonianSearchResult res;
+        if(_sz < 2) return res;
+        HamiltonianSearch search(*this, options);
+        if(search.failsNecessaryConditions()) return res;
+        res.cycle = _sz <= max_hamiltonian_dp_nodes ? search.runDP() : search.runBacktracking();
+        res.is_complete = res.cycle.has_value() || !search.isStopped();
+        if(res.is_complete && options.progress) options.progress(1.0);
+        return res;
+    }
+};
@@ -0,0 +1,123 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace debug {
+    std::optional<std::vector<uint8_t>> Graph::findBipartition(){
+        const uint8_t unknown = 2;
+        std::vector<uint8_t> side(_sz, unknown);
+        // directed graphs also walk incoming edges, undirected ones have every edge in both lists already
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        std::vector<uint32_t> queue;
+        for(uint32_t root = 0; root < _sz; root++){
+            if(side[root] != unknown) continue;
+            side[root] = 0;
+            queue.assign(1, root);
+            for(size_t head = 0; head < queue.size(); head++){
+                uint32_t v = queue[head];
+                for(int pass = 0; pass < (_is_directed ? 2 : 1); pass++){
+                    for(const auto& [u, i]: pass == 0 ? _adj_list[v] : reverse_adj_list[v]){
+                        if(side[u] == side[v]) return std::nullopt;
+                        if(side[u] != unknown) continue;
+                        side[u] = side[v] ^ 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }
+        return side;
+    }
+
+    std::optional<std::vector<uint32_t>> Graph::findMaximumMatching(){
+        auto side = findBipartition();
+        if(!side.has_value()) return std::nullopt;
+
+        // edges from the left side (0) to the right one (1) as a flat CSR
+        std::vector<uint32_t> offsets(_sz + 1, 0), head(_edges.size()), edge(_edges.size());
+        for(const auto& [x, y]: _edges) offsets[((*side)[x] == 0 ? x : y) + 1]++;
+        for(uint32_t v = 0; v < _sz; v++) offsets[v + 1] += offsets[v];
+        std::vector<uint32_t> position(offsets.begin(), offsets.end() - 1);
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            auto [left, right] = _edges[i];
+            if((*side)[left] != 0) std::swap(left, right);
+            head[position[left]] = right;
+            edge[position[left]++] = i;
+        }
+
+        // match_left holds the arc of a matched left node, match_right holds the left node matched to a right one
+        std::vector<uint32_t> match_left(_sz, no_parent), match_right(_sz, no_parent);
+        for(uint32_t u = 0; u < _sz; u++){
+            for(uint32_t a = offsets[u]; a < offsets[u + 1]; a++){
+                if(match_right[head[a]] != no_parent) continue;
+                match_right[head[a]] = u;
+                match_left[u] = a;
+                break;
+            }
+        }
+
+        std::vector<uint32_t> dist(_sz), queue, current(_sz), stack;
+        while(true){
+            // BFS layers from the free left nodes, only the shortest augmenting paths are used in a phase
+            queue.clear();
+            for(uint32_t u = 0; u < _sz; u++){
+                bool is_free = (*side)[u] == 0 && match_left[u] == no_parent;
+                dist[u] = is_free ? 0 : no_parent;
+                if(is_free) queue.push_back(u);
+            }
+            uint32_t limit = no_parent;
+            for(size_t h = 0; h < queue.size(); h++){
+                uint32_t u = queue[h];
+                if(dist[u] >= limit) break;
+                for(uint32_t a = offsets[u]; a < offsets[u + 1]; a++){
+                    uint32_t w = match_right[head[a]];
+                    if(w == no_parent){
+                        limit = std::min(limit, dist[u] + 1);
+                    }
+                    else if(dist[w] == no_parent){
+                        dist[w] = dist[u] + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+            if(limit == no_parent) break;
+
+            // iterative DFS along the layers with current-arc pointers, stack holds the left nodes of the path
+            std::copy(offsets.begin(), offsets.end() - 1, current.begin());
+            for(uint32_t root = 0; root < _sz; root++){
+                if((*side)[root] != 0 || match_left[root] != no_parent || dist[root] != 0) continue;
+                stack.assign(1, root);
+                while(!stack.empty()){
+                    uint32_t u = stack.back();
+                    if(current[u] == offsets[u + 1]){
+                        dist[u] = no_parent;
+                        stack.pop_back();
+                        if(!stack.empty()) current[stack.back()]++;
+                        continue;
+                    }
+                    uint32_t w = match_right[head[current[u]]];
+                    if(w == no_parent && dist[u] + 1 == limit){
+                        // every left node of the path takes the right node its current arc leads to
+                        for(uint32_t x: stack){
+                            match_right[head[current[x]]] = x;
+                            match_left[x] = current[x];
+                        }
+                        stack.clear();
+                    }
+                    else if(w != no_parent && dist[w] == dist[u] + 1){
+                        stack.push_back(w);
+                    }
+                    else{
+                        current[u]++;
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> matching;
+        for(uint32_t u = 0; u < _sz; u++){
+            if(match_left[u] != no_parent) matching.push_back(edge[match_left[u]]);
+        }
+        return matching;
+    }
+};
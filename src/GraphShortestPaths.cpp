@@ -0,0 +1,620 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    namespace {
+        // start -> meeting along parent, then meeting -> finish along backward_parent
+        void joinPaths(uint32_t meeting, const std::vector<uint32_t>& parent, const std::vector<uint32_t>& backward_parent, uint32_t no_parent, std::vector<uint32_t>& path) {
+            path.clear();
+            for(uint32_t v = meeting; v != no_parent; v = parent[v]) path.push_back(v);
+            std::reverse(path.begin(), path.end());
+            for(uint32_t v = backward_parent[meeting]; v != no_parent; v = backward_parent[v]) path.push_back(v);
+        }
+
+        std::vector<uint32_t> readPath(uint32_t finish, const std::vector<uint32_t>& parent, uint32_t no_parent) {
+            std::vector<uint32_t> path;
+            for(uint32_t v = finish; v != no_parent; v = parent[v]) path.push_back(v);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+    }
+
+    std::pair<int64_t, int64_t> Graph::getWeightRange() const {
+        if(!_weight_range.has_value()){
+            if(_weights.empty()) _weight_range = {1, 1};
+            else{
+                auto [min_it, max_it] = std::minmax_element(_weights.begin(), _weights.end());
+                _weight_range = {*min_it, *max_it};
+            }
+        }
+        return *_weight_range;
+    }
+
+    void Graph::computeDistancesBFS(uint32_t source, ShortestPathWorkspace& workspace) const {
+        auto& dist = workspace.dist;
+        auto& parent = workspace.parent;
+        auto& queue = workspace.queue;
+        dist.assign(_sz, unreachable_distance);
+        parent.assign(_sz, no_parent);
+        queue.clear();
+        dist[source] = 0;
+        queue.push_back(source);
+        for(size_t head = 0; head < queue.size(); head++){
+            uint32_t v = queue[head];
+            for(const auto& [u, i]: _adj_list[v]){
+                if(dist[u] != unreachable_distance) continue;
+                dist[u] = dist[v] + 1;
+                parent[u] = v;
+                queue.push_back(u);
+            }
+        }
+    }
+
+    void Graph::computeDistancesDijkstra(uint32_t source, ShortestPathWorkspace& workspace, const std::vector<int64_t>& potential) const {
+        auto& dist = workspace.dist;
+        auto& parent = workspace.parent;
+        dist.assign(_sz, unreachable_distance);
+        parent.assign(_sz, no_parent);
+        dist[source] = 0;
+
+        auto [min_weight, max_weight] = getWeightRange();
+        auto weight = [&](uint32_t v, uint32_t u, uint32_t i) {
+            return potential.empty() ? _weights[i] : _weights[i] + potential[v] - potential[u];
+        };
+
+        if(potential.empty() && min_weight >= 0 && max_weight <= max_dial_weight){
+            // Dial's algorithm: a cyclic array of max_weight + 1 buckets, one per distance
+            auto& buckets = workspace.buckets;
+            size_t bucket_count = static_cast<size_t>(max_weight) + 1;
+            if(buckets.size() < bucket_count) buckets.resize(bucket_count);
+            for(size_t b = 0; b < bucket_count; b++) buckets[b].clear();
+            size_t pending = 1;
+            buckets[0].push_back(source);
+            for(int64_t current = 0; pending > 0; current++){
+                auto& bucket = buckets[static_cast<size_t>(current) % bucket_count];
+                // zero weight edges push into the bucket that is being processed, so no iterators here
+                for(size_t j = 0; j < bucket.size(); j++){
+                    uint32_t v = bucket[j];
+                    pending--;
+                    if(dist[v] != current) continue;
+                    for(const auto& [u, i]: _adj_list[v]){
+                        int64_t nd = current + _weights[i];
+                        if(nd < dist[u]){
+                            dist[u] = nd;
+                            parent[u] = v;
+                            buckets[static_cast<size_t>(nd) % bucket_count].push_back(u);
+                            pending++;
+                        }
+                    }
+                }
+                bucket.clear();
+            }
+        }
+        else{
+            auto& heap = workspace.radix_heap;
+            heap.clear();
+            heap.push(0, source);
+            while(!heap.empty()){
+                auto [key, v] = heap.pop();
+                int64_t c = static_cast<int64_t>(key);
+                if(c != dist[v]) continue;
+                for(const auto& [u, i]: _adj_list[v]){
+                    int64_t nd = c + weight(v, u, i);
+                    if(nd < dist[u]){
+                        dist[u] = nd;
+                        parent[u] = v;
+                        heap.push(static_cast<uint64_t>(nd), u);
+                    }
+                }
+            }
+        }
+    }
+
+    void Graph::computeDistancesDag(uint32_t source, ShortestPathWorkspace& workspace, bool longest) const {
+        const auto& order = getTopologicalSort().order;
+        auto& dist = workspace.dist;
+        auto& parent = workspace.parent;
+        dist.assign(_sz, unreachable_distance);
+        parent.assign(_sz, no_parent);
+        dist[source] = 0;
+        // nodes before the source in the order can't be reached from it
+        for(auto it = std::find(order.begin(), order.end(), source); it != order.end(); ++it){
+            uint32_t v = *it;
+            if(dist[v] == unreachable_distance) continue;
+            for(const auto& [u, i]: _adj_list[v]){
+                int64_t nd = dist[v] + (_weights.empty() ? 1 : _weights[i]);
+                if(dist[u] == unreachable_distance || (longest ? nd > dist[u] : nd < dist[u])){
+                    dist[u] = nd;
+                    parent[u] = v;
+                }
+            }
+        }
+    }
+
+    bool Graph::computeDistancesSPFA(std::optional<uint32_t> source, ShortestPathWorkspace& workspace) const {
+        auto& dist = workspace.dist;
+        auto& parent = workspace.parent;
+        auto& parent_edge = workspace.parent_edge;
+        auto& deque = workspace.deque;
+        auto& in_queue = workspace.in_queue;
+        dist.assign(_sz, source.has_value() ? unreachable_distance : 0);
+        parent.assign(_sz, no_parent);
+        parent_edge.assign(_sz, no_parent);
+        in_queue.assign(_sz, 0);
+        deque.clear();
+        workspace.negative_cycle.clear();
+
+        // sum of the distances of the queued nodes for LLL
+        int64_t queued_sum = 0;
+        auto push = [&](uint32_t v) {
+            in_queue[v] = 1;
+            queued_sum += dist[v];
+            // SLF: a node closer than the first one goes first
+            if(!deque.empty() && dist[v] < dist[deque.front()]) deque.push_front(v);
+            else deque.push_back(v);
+        };
+        if(source.has_value()){
+            dist[*source] = 0;
+            push(*source);
+        }
+        else{
+            for(uint32_t v = 0; v < _sz; v++) push(v);
+        }
+
+        // walks along the parent pointers, nodes of one walk are marked by its root. Nodes with unbounded distances are cut off already
+        std::vector<uint32_t> mark;
+        auto findParentCycle = [&]() {
+            mark.assign(_sz, no_parent);
+            for(uint32_t root = 0; root < _sz; root++){
+                uint32_t v = root;
+                while(v != no_parent && mark[v] == no_parent && dist[v] != unbounded_distance){
+                    mark[v] = root;
+                    v = parent[v];
+                }
+                if(v != no_parent && mark[v] == root) return v;
+            }
+            return no_parent;
+        };
+
+        size_t relaxations = 0;
+        std::vector<uint32_t> cut;
+        while(!deque.empty()){
+            // LLL: the first node goes to the back if it's further than the average of the queue. Only once per pop,
+            // moving nodes until one is below the average may go around the whole queue every time
+            uint32_t v = deque.front();
+            if(deque.size() > 1 && dist[v] != unbounded_distance && static_cast<double>(dist[v]) * static_cast<double>(deque.size()) > static_cast<double>(queued_sum)){
+                deque.pop_front();
+                deque.push_back(v);
+                v = deque.front();
+            }
+            deque.pop_front();
+            in_queue[v] = 0;
+            if(dist[v] == unbounded_distance) continue;
+            queued_sum -= dist[v];
+
+            for(const auto& [u, i]: _adj_list[v]){
+                // unbounded distances are never improved
+                int64_t nd = dist[v] + _weights[i];
+                if(nd >= dist[u]) continue;
+                if(in_queue[u]) queued_sum -= dist[u] - nd;
+                dist[u] = nd;
+                parent[u] = v;
+                parent_edge[u] = i;
+                if(!in_queue[u]) push(u);
+                if(++relaxations < _sz) continue;
+
+                relaxations = 0;
+                uint32_t x = findParentCycle();
+                if(x == no_parent) continue;
+                if(workspace.negative_cycle.empty()){
+                    uint32_t y = x;
+                    do{
+                        workspace.negative_cycle.push_back(parent_edge[y]);
+                        y = parent[y];
+                    } while(y != x);
+                    std::reverse(workspace.negative_cycle.begin(), workspace.negative_cycle.end());
+                }
+                // everything reachable from the cycle is cut off, so the search ends even if there are more cycles
+                cut.assign(1, x);
+                if(in_queue[x]) queued_sum -= dist[x];
+                dist[x] = unbounded_distance;
+                for(size_t head = 0; head < cut.size(); head++){
+                    for(const auto& [y, j]: _adj_list[cut[head]]){
+                        if(dist[y] == unbounded_distance) continue;
+                        if(in_queue[y]) queued_sum -= dist[y];
+                        dist[y] = unbounded_distance;
+                        cut.push_back(y);
+                    }
+                }
+                if(dist[v] == unbounded_distance) break;
+            }
+        }
+        return workspace.negative_cycle.empty();
+    }
+
+    bool Graph::computeDistances(uint32_t source, ShortestPathWorkspace& workspace) const {
+        if(_weights.empty()) computeDistancesBFS(source, workspace);
+        else if(_is_directed && getTopologicalSort().cycle.empty()) computeDistancesDag(source, workspace);
+        else if(getWeightRange().first >= 0) computeDistancesDijkstra(source, workspace);
+        else return computeDistancesSPFA(source, workspace);
+        return true;
+    }
+
+    std::optional<std::vector<int64_t>> Graph::findJohnsonPotentials() const {
+        // a virtual source connected to every node with 0-weight edges, so every potential starts at 0
+        ShortestPathWorkspace workspace;
+        if(!computeDistancesSPFA(std::nullopt, workspace)) return std::nullopt;
+        return std::move(workspace.dist);
+    }
+
+    std::optional<std::vector<uint32_t>> Graph::findNegativeCycle(){
+        if(getWeightRange().first >= 0) return std::nullopt;
+        if(computeDistancesSPFA(std::nullopt, _workspace)) return std::nullopt;
+        return _workspace.negative_cycle;
+    }
+
+    template<typename F>
+    bool Graph::forEachSourceDistances(F&& f) const {
+        std::vector<int64_t> potential;
+        if(getWeightRange().first < 0){
+            auto johnson = findJohnsonPotentials();
+            if(!johnson.has_value()) return false;
+            potential = std::move(*johnson);
+        }
+
+        // one part per thread, every part reuses its own workspace and takes sources from the shared counter
+        size_t parts = std::min<size_t>(getThreadCount(), _sz);
+        std::atomic<uint32_t> next_source(0);
+        parallelFor(0, parts, [&](size_t) {
+            ShortestPathWorkspace workspace;
+            auto& dist = workspace.dist;
+            for(uint32_t source = next_source++; source < _sz; source = next_source++){
+                if(_weights.empty()){
+                    computeDistancesBFS(source, workspace);
+                }
+                else{
+                    computeDistancesDijkstra(source, workspace, potential);
+                    if(potential.size()){
+                        for(uint32_t v = 0; v < _sz; v++){
+                            if(dist[v] != unreachable_distance) dist[v] += potential[v] - potential[source];
+                        }
+                    }
+                }
+                f(source, dist);
+            }
+        });
+        return true;
+    }
+
+    std::vector<std::optional<int32_t>> Graph::findDistancesFromNode(uint32_t starting_node){
+        computeDistances(starting_node, _workspace);
+        std::vector<std::optional<int32_t>> dist(_sz, std::nullopt);
+        for(uint32_t v = 0; v < _sz; v++){
+            int64_t d = _workspace.dist[v];
+            if(d != unreachable_distance && d != unbounded_distance) dist[v] = saturateToInt32(d);
+        }
+        return dist;
+    }
+
+    std::vector<std::optional<int32_t>> Graph::findDistancesFromNodeParallel(uint32_t starting_node, int64_t delta){
+        auto [min_weight, max_weight] = getWeightRange();
+        if(min_weight < 0) return findDistancesFromNode(starting_node);
+        if(delta <= 0){
+            // roughly one bucket per average degree worth of the heaviest edge
+            int64_t average_degree = static_cast<int64_t>(2 * _edges.size() / std::max<size_t>(_sz, 1));
+            delta = std::max<int64_t>(1, max_weight / std::max<int64_t>(1, average_degree));
+        }
+
+        // light edges of v are edges[offsets[v]..light_end[v]), heavy ones are edges[light_end[v]..offsets[v + 1])
+        std::vector<size_t> offsets(_sz + 1, 0);
+        for(uint32_t v = 0; v < _sz; v++) offsets[v + 1] = offsets[v] + _adj_list[v].size();
+        std::vector<std::pair<uint32_t, int64_t>> edges(offsets.back());
+        std::vector<size_t> light_end(_sz);
+        parallelFor(0, _sz, [&](size_t v) {
+            size_t light = offsets[v], heavy = offsets[v + 1];
+            for(const auto& [u, i]: _adj_list[v]){
+                int64_t w = _weights.empty() ? 1 : _weights[i];
+                if(w <= delta) edges[light++] = {u, w};
+                else edges[--heavy] = {u, w};
+            }
+            light_end[v] = light;
+        }, 1024);
+
+        std::vector<std::atomic<int64_t>> dist(_sz);
+        for(auto& d: dist) d.store(unreachable_distance, std::memory_order_relaxed);
+        dist[starting_node] = 0;
+
+        // a relaxation from the bucket i never goes further than the bucket i + max_weight / delta + 1, so the buckets are cyclic
+        size_t bucket_count = static_cast<size_t>(max_weight / delta) + 2;
+        std::vector<std::vector<uint32_t>> buckets(bucket_count);
+        buckets[0].push_back(starting_node);
+        size_t pending = 1;
+
+        // every part of the frontier is relaxed by one thread and has its own output
+        size_t part_count = 4 * static_cast<size_t>(getThreadCount());
+        std::vector<std::vector<uint32_t>> improved(part_count);
+        auto relaxAll = [&](const std::vector<uint32_t>& nodes, bool light) {
+            // starting threads costs more than relaxing a small frontier
+            size_t parts = nodes.size() < 4096 ? 1 : part_count;
+            size_t part_size = (nodes.size() + parts - 1) / parts;
+            for(size_t part = parts; part < part_count; part++) improved[part].clear();
+            parallelFor(0, parts, [&](size_t part) {
+                auto& out = improved[part];
+                out.clear();
+                size_t first = part * part_size, last = std::min(nodes.size(), first + part_size);
+                for(size_t j = first; j < last; j++){
+                    uint32_t v = nodes[j];
+                    int64_t dv = dist[v].load(std::memory_order_relaxed);
+                    size_t from = light ? offsets[v] : light_end[v];
+                    size_t to = light ? light_end[v] : offsets[v + 1];
+                    for(size_t e = from; e < to; e++){
+                        auto [u, w] = edges[e];
+                        int64_t nd = dv + w;
+                        int64_t current = dist[u].load(std::memory_order_relaxed);
+                        while(nd < current){
+                            if(dist[u].compare_exchange_weak(current, nd, std::memory_order_relaxed)){
+                                out.push_back(u);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+        };
+
+        std::vector<uint32_t> frontier, next_frontier, settled;
+        for(int64_t i = 0; pending > 0; i++){
+            auto& bucket = buckets[static_cast<size_t>(i) % bucket_count];
+            if(bucket.empty()) continue;
+            pending -= bucket.size();
+            frontier.swap(bucket);
+            bucket.clear();
+            settled.clear();
+            while(!frontier.empty()){
+                // stale entries moved to an earlier bucket already, duplicates come from several improvements
+                frontier.erase(std::remove_if(frontier.begin(), frontier.end(), [&](uint32_t v) { return dist[v].load(std::memory_order_relaxed) / delta != i; }), frontier.end());
+                std::sort(frontier.begin(), frontier.end());
+                frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+
+                relaxAll(frontier, true);
+                next_frontier.clear();
+                for(const auto& out: improved){
+                    for(uint32_t u: out){
+                        int64_t b = dist[u].load(std::memory_order_relaxed) / delta;
+                        if(b == i) next_frontier.push_back(u);
+                        else{
+                            buckets[static_cast<size_t>(b) % bucket_count].push_back(u);
+                            pending++;
+                        }
+                    }
+                }
+                frontier.swap(next_frontier);
+            }
+
+            // heavy edges always lead to later buckets, so they are relaxed once per bucket
+            std::sort(settled.begin(), settled.end());
+            settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+            relaxAll(settled, false);
+            for(const auto& out: improved){
+                for(uint32_t u: out){
+                    buckets[static_cast<size_t>(dist[u].load(std::memory_order_relaxed) / delta) % bucket_count].push_back(u);
+                    pending++;
+                }
+            }
+        }
+
+        std::vector<std::optional<int32_t>> res(_sz, std::nullopt);
+        for(uint32_t v = 0; v < _sz; v++){
+            int64_t d = dist[v].load(std::memory_order_relaxed);
+            if(d != unreachable_distance) res[v] = saturateToInt32(d);
+        }
+        return res;
+    }
+
+    bool Graph::findPathBidirectionalBFS(uint32_t start, uint32_t finish, ShortestPathWorkspace& workspace) const {
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        workspace.dist.assign(_sz, unreachable_distance);
+        workspace.parent.assign(_sz, no_parent);
+        workspace.backward_dist.assign(_sz, unreachable_distance);
+        workspace.backward_parent.assign(_sz, no_parent);
+        workspace.dist[start] = 0;
+        workspace.backward_dist[finish] = 0;
+
+        std::vector<uint32_t> frontier = {start}, backward_frontier = {finish}, next_frontier;
+        uint32_t meeting = start == finish ? start : no_parent;
+        while(meeting == no_parent && !frontier.empty() && !backward_frontier.empty()){
+            // a whole level of the smaller side is expanded, every meeting on it gives a candidate and the shortest one wins
+            bool forward = frontier.size() <= backward_frontier.size();
+            auto& current = forward ? frontier : backward_frontier;
+            const auto& adj = forward ? _adj_list : reverse_adj_list;
+            auto& dist = forward ? workspace.dist : workspace.backward_dist;
+            auto& parent = forward ? workspace.parent : workspace.backward_parent;
+            const auto& other_dist = forward ? workspace.backward_dist : workspace.dist;
+            int64_t best = unreachable_distance;
+            next_frontier.clear();
+            for(uint32_t v: current){
+                for(const auto& [u, i]: adj[v]){
+                    if(dist[u] != unreachable_distance) continue;
+                    dist[u] = dist[v] + 1;
+                    parent[u] = v;
+                    next_frontier.push_back(u);
+                    if(other_dist[u] != unreachable_distance && dist[u] + other_dist[u] < best){
+                        best = dist[u] + other_dist[u];
+                        meeting = u;
+                    }
+                }
+            }
+            current.swap(next_frontier);
+        }
+        if(meeting == no_parent) return false;
+        joinPaths(meeting, workspace.parent, workspace.backward_parent, no_parent, workspace.queue);
+        return true;
+    }
+
+    bool Graph::findPathBidirectionalDijkstra(uint32_t start, uint32_t finish, ShortestPathWorkspace& workspace) const {
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        workspace.dist.assign(_sz, unreachable_distance);
+        workspace.parent.assign(_sz, no_parent);
+        workspace.backward_dist.assign(_sz, unreachable_distance);
+        workspace.backward_parent.assign(_sz, no_parent);
+        workspace.dist[start] = 0;
+        workspace.backward_dist[finish] = 0;
+
+        using Item = std::pair<int64_t, uint32_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> forward_heap, backward_heap;
+        forward_heap.push({0, start});
+        backward_heap.push({0, finish});
+        int64_t best = start == finish ? 0 : unreachable_distance;
+        uint32_t meeting = start == finish ? start : no_parent;
+        while(!forward_heap.empty() && !backward_heap.empty()){
+            // every path that is not found yet is at least as long as the sum of the tops
+            if(forward_heap.top().first + backward_heap.top().first >= best) break;
+            bool forward = forward_heap.size() <= backward_heap.size();
+            auto& heap = forward ? forward_heap : backward_heap;
+            const auto& adj = forward ? _adj_list : reverse_adj_list;
+            auto& dist = forward ? workspace.dist : workspace.backward_dist;
+            auto& parent = forward ? workspace.parent : workspace.backward_parent;
+            const auto& other_dist = forward ? workspace.backward_dist : workspace.dist;
+
+            auto [c, v] = heap.top();
+            heap.pop();
+            if(c != dist[v]) continue;
+            for(const auto& [u, i]: adj[v]){
+                int64_t nd = c + _weights[i];
+                if(nd >= dist[u]) continue;
+                dist[u] = nd;
+                parent[u] = v;
+                heap.push({nd, u});
+                if(other_dist[u] != unreachable_distance && nd + other_dist[u] < best){
+                    best = nd + other_dist[u];
+                    meeting = u;
+                }
+            }
+        }
+        if(meeting == no_parent) return false;
+        joinPaths(meeting, workspace.parent, workspace.backward_parent, no_parent, workspace.queue);
+        return true;
+    }
+
+    std::optional<std::vector<uint32_t>> Graph::findShortestPathBetweenNodes(uint32_t start, uint32_t finish){
+        if(_weights.empty() || getWeightRange().first >= 0){
+            bool found = _weights.empty() ? findPathBidirectionalBFS(start, finish, _workspace) : findPathBidirectionalDijkstra(start, finish, _workspace);
+            if(!found) return std::nullopt;
+            return _workspace.queue;
+        }
+
+        computeDistances(start, _workspace);
+        if(_workspace.dist[finish] == unreachable_distance || _workspace.dist[finish] == unbounded_distance) return std::nullopt;
+        return readPath(finish, _workspace.parent, no_parent);
+    }
+
+    std::optional<std::vector<uint32_t>> Graph::findShortestPathBetweenNodes(uint32_t start, uint32_t finish, const std::function<int64_t(uint32_t)>& heuristic){
+        auto& dist = _workspace.dist;
+        auto& parent = _workspace.parent;
+        dist.assign(_sz, unreachable_distance);
+        parent.assign(_sz, no_parent);
+        dist[start] = 0;
+
+        // {distance + heuristic, distance, node}, with an inconsistent heuristic a node may be expanded several times
+        using Item = std::tuple<int64_t, int64_t, uint32_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+        heap.push({heuristic(start), 0, start});
+        while(!heap.empty()){
+            auto [f, c, v] = heap.top();
+            heap.pop();
+            if(c != dist[v]) continue;
+            if(v == finish) break;
+            for(const auto& [u, i]: _adj_list[v]){
+                int64_t nd = c + (_weights.empty() ? 1 : _weights[i]);
+                if(nd >= dist[u]) continue;
+                dist[u] = nd;
+                parent[u] = v;
+                heap.push({nd + heuristic(u), nd, u});
+            }
+        }
+
+        if(dist[finish] == unreachable_distance) return std::nullopt;
+        return readPath(finish, parent, no_parent);
+    }
+
+    std::optional<std::vector<std::optional<int32_t>>> Graph::findLongestDistancesFromNode(uint32_t starting_node){
+        if(!getTopologicalSort().cycle.empty()) return std::nullopt;
+        computeDistancesDag(starting_node, _workspace, true);
+        std::vector<std::optional<int32_t>> dist(_sz, std::nullopt);
+        for(uint32_t v = 0; v < _sz; v++){
+            if(_workspace.dist[v] != unreachable_distance) dist[v] = saturateToInt32(_workspace.dist[v]);
+        }
+        return dist;
+    }
+
+    std::optional<std::vector<uint32_t>> Graph::findLongestPathBetweenNodes(uint32_t start, uint32_t finish){
+        if(!getTopologicalSort().cycle.empty()) return std::nullopt;
+        computeDistancesDag(start, _workspace, true);
+        if(_workspace.dist[finish] == unreachable_distance) return std::nullopt;
+        return readPath(finish, _workspace.parent, no_parent);
+    }
+
+    std::vector<std::vector<std::optional<int32_t>>> Graph::findPairwiseDistances(){
+        return findPairwiseDistanceMatrix().toVectors();
+    }
+
+    DistanceMatrix Graph::findPairwiseDistanceMatrix(){
+        DistanceMatrix res(_sz);
+        // n runs of Dijkstra cost about n * m * log(n), tiled Floyd-Warshall costs n^3 but is several times cheaper per step
+        double n = static_cast<double>(_sz), m = static_cast<double>(_edges.size());
+        bool is_sparse = _weights.empty() || 4 * m * std::log2(n + 1) < n * n;
+        if(is_sparse){
+            bool ok = forEachSourceDistances([&res, this](uint32_t source, const std::vector<int64_t>& dist) {
+                int64_t* row = res.mutateRow(source);
+                for(uint32_t v = 0; v < _sz; v++){
+                    if(dist[v] != unreachable_distance) row[v] = dist[v];
+                }
+            });
+            if(ok) return res;
+            res = DistanceMatrix(_sz);
+        }
+
+        auto sparse = getSparseAdjacencyMatrix();
+        for(uint32_t v = 0; v < _sz; v++){
+            auto columns = sparse.getRowColumnsBegin(v);
+            auto values = sparse.getRowValues(v);
+            int64_t* row = res.mutateRow(v);
+            for(size_t i = 0; columns + i != sparse.getRowColumnsEnd(v); i++){
+                if(columns[i] != v) row[columns[i]] = values[i];
+            }
+        }
+        res.floydWarshall();
+        return res;
+    }
+
+    void Graph::findPairwiseDistances(const std::function<void(uint32_t, const std::vector<std::optional<int32_t>>&)>& row_callback){
+        std::mutex callback_mutex;
+        bool ok = forEachSourceDistances([&](uint32_t source, const std::vector<int64_t>& dist) {
+            std::vector<std::optional<int32_t>> row(_sz, std::nullopt);
+            for(uint32_t v = 0; v < _sz; v++){
+                if(dist[v] != unreachable_distance) row[v] = saturateToInt32(dist[v]);
+            }
+            std::lock_guard lock(callback_mutex);
+            row_callback(source, row);
+        });
+        if(ok) return;
+
+        // negative cycle, the results are as meaningless as Floyd-Warshall's ones
+        auto res = findPairwiseDistanceMatrix();
+        std::vector<std::optional<int32_t>> row(_sz);
+        for(uint32_t source = 0; source < _sz; source++){
+            for(uint32_t v = 0; v < _sz; v++) row[v] = res.get(source, v);
+            row_callback(source, row);
+        }
+    }
+};
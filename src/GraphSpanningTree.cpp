@@ -0,0 +1,123 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    namespace {
+        // ranges up to this size are sorted and given to plain Kruskal's algorithm
+        const size_t filter_kruskal_threshold = 1 << 12;
+        // filtering of smaller ranges isn't worth starting threads
+        const size_t parallel_filter_threshold = 1 << 16;
+    }
+
+    std::vector<uint32_t> Graph::findMinimumSpanningTree(){
+        DisjointSets sets(_sz);
+        std::vector<uint32_t> forest;
+        forest.reserve(_sz - 1);
+        std::vector<uint32_t> indices(_edges.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        using Iter = std::vector<uint32_t>::iterator;
+
+        auto kruskal = [&](Iter begin, Iter end) {
+            for(auto it = begin; it != end && forest.size() + 1 < _sz; it++){
+                if(sets.unite(_edges[*it].first, _edges[*it].second)) forest.push_back(*it);
+            }
+        };
+        if(_weights.empty()){
+            kruskal(indices.begin(), indices.end());
+            return forest;
+        }
+
+        // (weight, index) is a strict order, so every pivot splits a range into two non-empty parts
+        auto less = [this](uint32_t i, uint32_t j) { return _weights[i] < _weights[j] || (_weights[i] == _weights[j] && i < j); };
+        std::vector<char> keep;
+        auto filterKruskal = [&](auto& self, Iter begin, Iter end) -> void {
+            if(forest.size() + 1 >= _sz) return;
+            size_t size = static_cast<size_t>(end - begin);
+            if(size <= filter_kruskal_threshold){
+                std::sort(begin, end, less);
+                kruskal(begin, end);
+                return;
+            }
+            uint32_t a = begin[0], b = begin[static_cast<ptrdiff_t>(size / 2)], c = end[-1];
+            if(less(b, a)) std::swap(a, b);
+            if(less(c, b)) std::swap(b, c);
+            if(less(b, a)) std::swap(a, b);
+            uint32_t pivot = b;
+            Iter middle = std::partition(begin, end, [&](uint32_t i) { return less(i, pivot); });
+            self(self, begin, middle);
+
+            // heavy edges inside the already connected parts can't get into the forest
+            size = static_cast<size_t>(end - middle);
+            Iter last;
+            if(size < parallel_filter_threshold){
+                last = std::remove_if(middle, end, [&](uint32_t i) { return sets.find(_edges[i].first) == sets.find(_edges[i].second); });
+            }
+            else{
+                keep.assign(size, 0);
+                parallelFor(0, size, [&](size_t j) {
+                    auto [u, v] = _edges[middle[static_cast<ptrdiff_t>(j)]];
+                    keep[j] = sets.findWithoutCompression(u) != sets.findWithoutCompression(v);
+                }, 4096);
+                last = middle;
+                for(size_t j = 0; j < size; j++){
+                    if(keep[j]) *last++ = middle[static_cast<ptrdiff_t>(j)];
+                }
+            }
+            self(self, middle, last);
+        };
+        filterKruskal(filterKruskal, indices.begin(), indices.end());
+        return forest;
+    }
+
+    std::vector<uint32_t> Graph::findMinimumSpanningTreeParallel(){
+        auto less = [this](uint32_t i, uint32_t j) {
+            if(_weights.empty() || _weights[i] == _weights[j]) return i < j;
+            return _weights[i] < _weights[j];
+        };
+
+        DisjointSets sets(_sz);
+        std::vector<uint32_t> forest;
+        std::vector<uint32_t> component(_sz);
+        std::iota(component.begin(), component.end(), 0);
+        std::vector<uint32_t> candidates;
+        for(uint32_t i = 0; i < _edges.size(); i++){
+            if(_edges[i].first != _edges[i].second) candidates.push_back(i);
+        }
+        std::vector<std::atomic<uint32_t>> cheapest(_sz);
+        std::vector<char> keep;
+
+        // every round every component takes its cheapest outgoing edge, so the number of components at least halves
+        while(!candidates.empty()){
+            parallelFor(0, _sz, [&](size_t v) { cheapest[v].store(no_parent, std::memory_order_relaxed); }, 4096);
+            parallelFor(0, candidates.size(), [&](size_t j) {
+                uint32_t i = candidates[j];
+                for(uint32_t c: {component[_edges[i].first], component[_edges[i].second]}){
+                    uint32_t current = cheapest[c].load(std::memory_order_relaxed);
+                    while((current == no_parent || less(i, current)) && !cheapest[c].compare_exchange_weak(current, i, std::memory_order_relaxed));
+                }
+            }, 4096);
+
+            for(uint32_t c = 0; c < _sz; c++){
+                uint32_t i = cheapest[c].load(std::memory_order_relaxed);
+                if(i != no_parent && sets.unite(_edges[i].first, _edges[i].second)) forest.push_back(i);
+            }
+
+            parallelFor(0, _sz, [&](size_t v) { component[v] = sets.findWithoutCompression(static_cast<uint32_t>(v)); }, 4096);
+            keep.assign(candidates.size(), 0);
+            parallelFor(0, candidates.size(), [&](size_t j) {
+                auto [u, v] = _edges[candidates[j]];
+                keep[j] = component[u] != component[v];
+            }, 4096);
+            size_t last = 0;
+            for(size_t j = 0; j < candidates.size(); j++){
+                if(keep[j]) candidates[last++] = candidates[j];
+            }
+            candidates.resize(last);
+        }
+        return forest;
+    }
+};
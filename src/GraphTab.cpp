@@ -1113,13 +1113,14 @@ namespace debug {
     void GraphTab::setNodeLabels(const std::vector<std::string>& labels){
         std::lock_guard lock(_mutating_mutex);
         const auto& node_indices = _available_node_indices.getData();
-        for(uint32_t i = 0; i < std::min(node_indices.size(), _node_labels.size()); i++) {
+        for(uint32_t i = 0; i < std::min({labels.size(), node_indices.size(), _node_labels.size()}); i++) {
             auto& str = mutateString(_node_labels[node_indices[i]]);
             str = labels[i];
         }
     }
 
     std::vector<std::pair<uint32_t, uint32_t>> GraphTab::getEdges() const{
+        std::lock_guard lock(_mutating_mutex);
         std::vector<std::pair<uint32_t, uint32_t>> edges;
         const auto& e = _edges.getData();
         for(const auto& edge_index: _available_edge_indices.getData()) {
@@ -1128,13 +1129,60 @@ namespace debug {
         return edges;
     }
 
-    void GraphTab::setEdges(const std::vector<std::pair<uint32_t, uint32_t>>& edges){
+    std::vector<std::pair<float, float>> GraphTab::getNodeCoords() const{
         std::lock_guard lock(_mutating_mutex);
-        auto cpy = _available_edge_indices.getData();
-        for(const auto& edge_index: cpy) {
-            deleteEdge(edge_index);
+        std::vector<std::pair<float, float>> coords;
+        const auto& c = _node_coords.getData();
+        for(const auto& node_index: _available_node_indices.getData()) {
+            coords.push_back(c[node_index]);
+        }
+        return coords;
+    }
+
+    void GraphTab::setEdges(size_t node_count, const std::vector<std::pair<uint32_t, uint32_t>>& edges){
+        std::lock_guard lock(_mutating_mutex);
+        // new nodes go to random places inside the current drawing
+        if(_available_node_indices.getData().size() < node_count){
+            float min_x = 0, max_x = 800, min_y = 0, max_y = 600;
+            const auto& coords = _node_coords.getData();
+            if(!coords.empty()){
+                auto [x_min, x_max] = std::minmax_element(coords.begin(), coords.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+                auto [y_min, y_max] = std::minmax_element(coords.begin(), coords.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+                min_x = x_min->first;
+                max_x = std::max(x_max->first, min_x + 1);
+                min_y = y_min->second;
+                max_y = std::max(y_max->second, min_y + 1);
+            }
+            std::mt19937 rng(static_cast<uint32_t>(node_count));
+            auto distr_x = std::uniform_real_distribution<float>(min_x, max_x);
+            auto distr_y = std::uniform_real_distribution<float>(min_y, max_y);
+            for(size_t i = _available_node_indices.getData().size(); i < node_count; i++){
+                addNode(std::make_pair(distr_x(rng), distr_y(rng)), {_default_node_color, _default_node_radius}, std::to_string(i));
+            }
+        }
+
+        // the edge arrays are rebuilt as a whole, deleting edges one by one costs O(m) each
+        std::vector<char> is_edge_label(_strings.size(), 0);
+        for(uint32_t edge_index: _available_edge_indices.getData()) {
+            is_edge_label[_edge_labels[edge_index]] = 1;
+            _deleted_string_indices.push_back(_edge_labels[edge_index]);
         }
+        auto& string_indices = _available_string_indices.mutateData();
+        string_indices.erase(std::remove_if(string_indices.begin(), string_indices.end(), [&](uint32_t i) { return is_edge_label[i]; }), string_indices.end());
+        _was_mutated = true;
+
+        _edges.mutateData().clear();
+        _available_edge_indices.mutateData().clear();
+        _deleted_edge_indices.clear();
+        _mutli_edge_index.mutateData().clear();
+        _multi_edge_indices.clear();
+        _edge_properties.mutateData().clear();
+        _edge_labels.clear();
+
+        size_t coord_count = _node_coords.getData().size();
         for(auto edge: edges) {
+            // edges to nodes the tab doesn't have would read past the coordinates
+            if(edge.first >= coord_count || edge.second >= coord_count) continue;
             addEdge(edge, {_default_edge_color, _default_edge_thickness});
         }
     }
@@ -1148,6 +1196,16 @@ namespace debug {
         }
     }
 
+    void GraphTab::setEdgeColors(const std::vector<uint32_t>& edge_indices, const std::vector<uint32_t>& colors){
+        std::lock_guard lock(_mutating_mutex);
+        const auto& available_indices = _available_edge_indices.getData();
+        auto& properties = _edge_properties.mutateData(); 
+        for(size_t i = 0; i < std::min(edge_indices.size(), colors.size()); i++) {
+            if(edge_indices[i] >= available_indices.size()) continue;
+            properties[available_indices[edge_indices[i]]].color = colors[i];
+        }
+    }
+
     void GraphTab::setEdgeLabels(const std::vector<std::string>& labels){
         std::lock_guard lock(_mutating_mutex);
         const auto& edge_indices = _available_edge_indices.getData();
@@ -0,0 +1,253 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    namespace {
+        // stack of fixed-size chunks: frames never move and a deep search doesn't need one huge reallocation
+        template<typename T>
+        class ArenaStack{
+            static constexpr size_t chunk_size = 1 << 16;
+            std::vector<std::unique_ptr<T[]>> _chunks;
+            size_t _size = 0;
+        public:
+            bool empty() const { return _size == 0; }
+            T& top() { return _chunks[(_size - 1) / chunk_size][(_size - 1) % chunk_size]; }
+            void pop() { _size--; }
+            void push(const T& value) {
+                if(_size == _chunks.size() * chunk_size) _chunks.push_back(std::make_unique<T[]>(chunk_size));
+                _size++;
+                top() = value;
+            }
+        };
+
+        struct DfsFrame{
+            uint32_t node;
+            uint32_t parent_edge;
+            uint32_t next; // position in the adjacency list
+        };
+    }
+
+    void Graph::traverseLevels(uint32_t start, bool parallel, std::vector<uint32_t>& parent, std::vector<uint32_t>& parent_edge, const std::function<void(uint32_t, const std::vector<uint32_t>&)>& level_callback) const {
+        // Beamer's thresholds: bottom-up once the frontier has more than 1/14 of the unvisited edges, top-down again below 1/24 of the nodes
+        const size_t alpha = 14, beta = 24;
+        const auto& reverse_adj_list = getReverseAdjacencyList();
+        size_t words = (static_cast<size_t>(_sz) + 63) / 64;
+
+        std::vector<std::atomic<uint64_t>> visited(words);
+        for(auto& word: visited) word.store(0, std::memory_order_relaxed);
+        // bits past the last node are marked visited, so bottom-up steps never look at them
+        if(_sz % 64) visited[words - 1].store(~uint64_t(0) << (_sz % 64), std::memory_order_relaxed);
+        visited[start >> 6].fetch_or(uint64_t(1) << (start & 63), std::memory_order_relaxed);
+        std::vector<uint64_t> frontier_bits(words);
+
+        parent.assign(_sz, no_parent);
+        parent_edge.assign(_sz, no_parent);
+
+        size_t unvisited_edges = 0;
+        for(uint32_t v = 0; v < _sz; v++) unvisited_edges += _adj_list[v].size();
+        unvisited_edges -= _adj_list[start].size();
+
+        // every part of a level is expanded by one thread and has its own output, small levels aren't worth starting threads
+        size_t part_count = parallel ? 4 * static_cast<size_t>(getThreadCount()) : 1;
+        std::vector<std::vector<uint32_t>> discovered(part_count);
+
+        std::vector<uint32_t> frontier = {start};
+        bool bottom_up = false;
+        for(uint32_t level = 0; !frontier.empty(); level++){
+            level_callback(level, frontier);
+
+            size_t frontier_edges = 0;
+            for(uint32_t v: frontier) frontier_edges += _adj_list[v].size();
+            if(!bottom_up && frontier_edges > unvisited_edges / alpha) bottom_up = true;
+            else if(bottom_up && frontier.size() < _sz / beta) bottom_up = false;
+
+            if(!bottom_up){
+                size_t parts = frontier.size() < 4096 ? 1 : part_count;
+                size_t part_size = (frontier.size() + parts - 1) / parts;
+                for(size_t part = parts; part < part_count; part++) discovered[part].clear();
+                parallelFor(0, parts, [&](size_t part) {
+                    auto& out = discovered[part];
+                    out.clear();
+                    size_t first = part * part_size, last = std::min(frontier.size(), first + part_size);
+                    for(size_t j = first; j < last; j++){
+                        uint32_t v = frontier[j];
+                        for(const auto& [u, i]: _adj_list[v]){
+                            uint64_t bit = uint64_t(1) << (u & 63);
+                            auto& word = visited[u >> 6];
+                            if(word.load(std::memory_order_relaxed) & bit) continue;
+                            // the first thread to set the bit owns the node
+                            if(parts > 1){
+                                if(word.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                            }
+                            else{
+                                word.store(word.load(std::memory_order_relaxed) | bit, std::memory_order_relaxed);
+                            }
+                            parent[u] = v;
+                            parent_edge[u] = i;
+                            out.push_back(u);
+                        }
+                    }
+                });
+            }
+            else{
+                std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+                for(uint32_t v: frontier) frontier_bits[v >> 6] |= uint64_t(1) << (v & 63);
+
+                // parts are ranges of whole words, so every word of visited is written by one thread only
+                size_t parts = std::min(part_count, words);
+                size_t part_size = (words + parts - 1) / parts;
+                for(size_t part = parts; part < part_count; part++) discovered[part].clear();
+                parallelFor(0, parts, [&](size_t part) {
+                    auto& out = discovered[part];
+                    out.clear();
+                    size_t first = part * part_size, last = std::min(words, first + part_size);
+                    for(size_t w = first; w < last; w++){
+                        uint64_t current = visited[w].load(std::memory_order_relaxed);
+                        uint64_t unvisited = ~current;
+                        while(unvisited){
+                            uint32_t v = static_cast<uint32_t>(w * 64 + static_cast<size_t>(countTrailingZeros64(unvisited)));
+                            unvisited &= unvisited - 1;
+                            for(const auto& [u, i]: reverse_adj_list[v]){
+                                if(!(frontier_bits[u >> 6] >> (u & 63) & 1)) continue;
+                                parent[v] = u;
+                                parent_edge[v] = i;
+                                current |= uint64_t(1) << (v & 63);
+                                out.push_back(v);
+                                break;
+                            }
+                        }
+                        visited[w].store(current, std::memory_order_relaxed);
+                    }
+                });
+            }
+
+            frontier.clear();
+            for(const auto& out: discovered){
+                frontier.insert(frontier.end(), out.begin(), out.end());
+            }
+            for(uint32_t v: frontier) unvisited_edges -= _adj_list[v].size();
+        }
+    }
+
+    void Graph::bfsByLevels(uint32_t starting_node, const std::function<void(uint32_t, const std::vector<uint32_t>&)>& f, bool parallel){
+        std::vector<uint32_t> parent, parent_edge;
+        traverseLevels(starting_node, parallel, parent, parent_edge, f);
+    }
+
+    void Graph::runDepthFirstSearch(std::optional<uint32_t> start, const DfsCallbacks& callbacks, bool by_edges) const {
+        enum : uint8_t { unvisited = 0, on_stack = 1, finished = 2 };
+        std::vector<uint8_t> state(by_edges ? 0 : _sz, unvisited);
+        // Hierholzer's walk keeps one position per node instead of one per frame, so every edge is looked at once
+        std::vector<char> used_edges(by_edges ? _edges.size() : 0);
+        std::vector<uint32_t> cursor(by_edges ? _sz : 0);
+        // preorder numbers tell forward edges from cross ones, only directed graphs have them
+        bool need_order = !by_edges && _is_directed && callbacks.edge;
+        std::vector<uint32_t> order(need_order ? _sz : 0);
+        uint32_t counter = 0;
+        ArenaStack<DfsFrame> stack;
+
+        auto enter = [&](uint32_t v, uint32_t parent_edge) {
+            if(!by_edges) state[v] = on_stack;
+            if(need_order) order[v] = counter++;
+            if(callbacks.preorder) callbacks.preorder(v, parent_edge);
+            stack.push({v, parent_edge, 0});
+        };
+
+        uint32_t first_root = start.value_or(0), last_root = start.has_value() ? *start + 1 : _sz;
+        for(uint32_t root = first_root; root < last_root; root++){
+            if(!by_edges && state[root] != unvisited) continue;
+            enter(root, no_parent);
+            while(!stack.empty()){
+                DfsFrame& frame = stack.top();
+                uint32_t v = frame.node;
+                uint32_t& next = by_edges ? cursor[v] : frame.next;
+                if(next == _adj_list[v].size()){
+                    uint32_t parent_edge = frame.parent_edge;
+                    stack.pop();
+                    if(!by_edges) state[v] = finished;
+                    if(callbacks.postorder) callbacks.postorder(v, parent_edge);
+                    continue;
+                }
+
+                auto [u, i] = _adj_list[v][next++];
+                if(by_edges){
+                    if(used_edges[i]) continue;
+                    used_edges[i] = 1;
+                    if(callbacks.edge) callbacks.edge(v, u, i, DfsEdgeType::tree);
+                    enter(u, i);
+                    continue;
+                }
+
+                // the tree edge seen from the child, parallel edges have other indices and are back edges
+                if(!_is_directed && i == frame.parent_edge) continue;
+                // an undirected self-loop has two entries in the list of v, only the first one is reported
+                if(!_is_directed && u == v && !isFirstSelfLoopEntry(v, next - 1)) continue;
+                DfsEdgeType type;
+                if(state[u] == unvisited) type = DfsEdgeType::tree;
+                else if(state[u] == on_stack) type = DfsEdgeType::back;
+                else if(!_is_directed) continue; // the other end of a back edge, which is reported already
+                else type = need_order && order[u] > order[v] ? DfsEdgeType::forward : DfsEdgeType::cross;
+
+                if(callbacks.edge) callbacks.edge(v, u, i, type);
+                if(type == DfsEdgeType::tree) enter(u, i);
+            }
+        }
+    }
+
+    void Graph::depthFirstSearch(uint32_t starting_node, const DfsCallbacks& callbacks){
+        runDepthFirstSearch(starting_node, callbacks, false);
+    }
+
+    void Graph::depthFirstSearch(const DfsCallbacks& callbacks){
+        runDepthFirstSearch(std::nullopt, callbacks, false);
+    }
+
+    const TopologicalSort& Graph::getTopologicalSort() const {
+        if(_topological_sort.has_value()) return *_topological_sort;
+        TopologicalSort res;
+        std::vector<uint32_t> in_degree(_sz, 0);
+        for(uint32_t v = 0; v < _sz; v++){
+            for(const auto& [u, i]: _adj_list[v]) in_degree[u]++;
+        }
+        auto& order = res.order;
+        order.reserve(_sz);
+        for(uint32_t v = 0; v < _sz; v++){
+            if(in_degree[v] == 0) order.push_back(v);
+        }
+        for(size_t head = 0; head < order.size(); head++){
+            for(const auto& [u, i]: _adj_list[order[head]]){
+                if(--in_degree[u] == 0) order.push_back(u);
+            }
+        }
+
+        if(order.size() < _sz){
+            // every node left has a predecessor which is left too, so walking back along them has to close a cycle
+            const auto& reverse_adj_list = getReverseAdjacencyList();
+            std::vector<uint32_t> position(_sz, no_parent), walk;
+            uint32_t v = static_cast<uint32_t>(std::find_if(in_degree.begin(), in_degree.end(), [](uint32_t d) { return d > 0; }) - in_degree.begin());
+            while(position[v] == no_parent){
+                position[v] = static_cast<uint32_t>(walk.size());
+                walk.push_back(v);
+                for(const auto& [u, i]: reverse_adj_list[v]){
+                    if(in_degree[u] == 0) continue;
+                    v = u;
+                    break;
+                }
+            }
+            // the walk goes against the edges, so the cycle is its tail reversed
+            res.cycle.assign(walk.rbegin(), walk.rend() - position[v]);
+        }
+        _topological_sort = std::move(res);
+        return *_topological_sort;
+    }
+
+    TopologicalSort Graph::findTopologicalSort(){
+        return getTopologicalSort();
+    }
+};
@@ -0,0 +1,111 @@
+#include "GraphDebugger.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace debug {
+    static std::atomic<uint32_t> thread_count_setting(0);
+
+    void setThreadCount(uint32_t thread_count) {
+        thread_count_setting = thread_count;
+    }
+
+    uint32_t getThreadCount() {
+        uint32_t res = thread_count_setting;
+        if(res == 0) res = std::thread::hardware_concurrency();
+        return std::max(res, 1u);
+    }
+
+    namespace {
+        // set while the thread runs a task, nested calls run inline instead of waiting for the busy pool
+        thread_local bool inside_task = false;
+
+        /*
+        Threads that sleep between tasks, so that algorithms calling parallelFor() in a loop don't pay for creating threads.
+        One task runs at a time, the helpers that haven't picked it up before the calling thread is done are skipped
+        */
+        class ThreadPool{
+            std::mutex _run_mutex;
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            std::condition_variable _done;
+            std::vector<std::thread> _threads;
+            const std::function<void()>* _task = nullptr;
+            uint64_t _generation = 0;
+            uint32_t _pending = 0;
+            uint32_t _running = 0;
+            bool _stopping = false;
+
+            void loop() {
+                inside_task = true;
+                uint64_t seen_generation = 0;
+                std::unique_lock lock(_mutex);
+                while(true){
+                    _wake.wait(lock, [&]() { return _stopping || (_pending > 0 && _generation != seen_generation); });
+                    if(_stopping) return;
+                    seen_generation = _generation;
+                    _pending--;
+                    _running++;
+                    const auto& task = *_task;
+                    lock.unlock();
+                    task();
+                    lock.lock();
+                    _running--;
+                    if(_running == 0) _done.notify_all();
+                }
+            }
+
+            void finish() {
+                std::unique_lock lock(_mutex);
+                _pending = 0;
+                _done.wait(lock, [&]() { return _running == 0; });
+                _task = nullptr;
+            }
+        public:
+            ~ThreadPool() {
+                {
+                    std::lock_guard lock(_mutex);
+                    _stopping = true;
+                }
+                _wake.notify_all();
+                for(auto& thread: _threads) thread.join();
+            }
+
+            void run(uint32_t helper_count, const std::function<void()>& task) {
+                std::unique_lock run_lock(_run_mutex, std::defer_lock);
+                if(helper_count == 0 || inside_task || !run_lock.try_lock()){
+                    task();
+                    return;
+                }
+                {
+                    std::lock_guard lock(_mutex);
+                    while(_threads.size() < helper_count) _threads.emplace_back([this]() { loop(); });
+                    _task = &task;
+                    _pending = helper_count;
+                    _generation++;
+                }
+                _wake.notify_all();
+
+                inside_task = true;
+                try{
+                    task();
+                }
+                catch(...){
+                    inside_task = false;
+                    finish();
+                    throw;
+                }
+                inside_task = false;
+                finish();
+            }
+        };
+    }
+
+    void runOnThreadPool(uint32_t helper_count, const std::function<void()>& task) {
+        static ThreadPool pool;
+        pool.run(helper_count, task);
+    }
+};
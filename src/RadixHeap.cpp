@@ -0,0 +1,49 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    RadixHeap::RadixHeap():
+        _last(0),
+        _size(0) {}
+
+    void RadixHeap::clear() {
+        for(auto& bucket: _buckets) bucket.clear();
+        _last = 0;
+        _size = 0;
+    }
+
+    bool RadixHeap::empty() const {
+        return _size == 0;
+    }
+
+    size_t RadixHeap::size() const {
+        return _size;
+    }
+
+    void RadixHeap::push(uint64_t key, uint32_t value) {
+        _buckets[bucketIndex(key, _last)].emplace_back(key, value);
+        _size++;
+    }
+
+    std::pair<uint64_t, uint32_t> RadixHeap::pop() {
+        if(_buckets[0].empty()){
+            // the smallest key of the first non-empty bucket becomes the new last key,
+            // all items of that bucket then fall into smaller buckets
+            size_t i = 1;
+            while(_buckets[i].empty()) i++;
+            auto& bucket = _buckets[i];
+            _last = std::min_element(bucket.begin(), bucket.end())->first;
+            for(const auto& item: bucket){
+                _buckets[bucketIndex(item.first, _last)].push_back(item);
+            }
+            bucket.clear();
+        }
+        auto res = _buckets[0].back();
+        _buckets[0].pop_back();
+        _size--;
+        return res;
+    }
+};
@@ -0,0 +1,57 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace debug {
+    SparseMatrix::SparseMatrix(uint32_t size, const std::vector<std::pair<uint32_t, uint32_t>>& cells, const std::vector<int64_t>& values):
+        _sz(size),
+        _offsets(size + 1, 0),
+        _columns({}),
+        _values({}) {
+            // counting sort by rows, then sorting every row by columns
+            for(const auto& [r, c]: cells) _offsets[r + 1]++;
+            for(uint32_t r = 0; r < _sz; r++) _offsets[r + 1] += _offsets[r];
+
+            std::vector<std::pair<uint32_t, int64_t>> entries(cells.size());
+            std::vector<uint32_t> fill(_offsets.begin(), _offsets.end() - 1);
+            for(size_t i = 0; i < cells.size(); i++){
+                entries[fill[cells[i].first]++] = {cells[i].second, values[i]};
+            }
+
+            _columns.reserve(entries.size());
+            _values.reserve(entries.size());
+            uint32_t written = 0;
+            for(uint32_t r = 0; r < _sz; r++){
+                auto first = entries.begin() + _offsets[r];
+                auto last = entries.begin() + _offsets[r + 1];
+                std::sort(first, last);
+                _offsets[r] = written;
+                for(auto it = first; it != last; it++){
+                    if(it != first && std::prev(it)->first == it->first) continue; // the smallest value comes first
+                    _columns.push_back(it->first);
+                    _values.push_back(it->second);
+                    written++;
+                }
+            }
+            _offsets[_sz] = written;
+        }
+
+    uint32_t SparseMatrix::size() const {
+        return _sz;
+    }
+
+    size_t SparseMatrix::getNonZeroCount() const {
+        return _columns.size();
+    }
+
+    std::optional<int64_t> SparseMatrix::get(uint32_t row, uint32_t col) const {
+        auto first = getRowColumnsBegin(row);
+        auto last = getRowColumnsEnd(row);
+        auto it = std::lower_bound(first, last, col);
+        if(it == last || *it != col) return std::nullopt;
+        return getRowValues(row)[it - first];
+    }
+};
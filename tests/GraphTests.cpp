@@ -0,0 +1,1383 @@
+#include "GraphDebugger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/*
+Behaviour checks of the algorithms against brute-force references on small random graphs, no window is opened.
+Usage: GraphDebuggerTests [test|all], every test is also registered in CTest under its name
+*/
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* expression, int line, int iteration) {
+        if(ok) return;
+        failures++;
+        std::fprintf(stderr, "GraphTests.cpp:%d, iteration %d: %s\n", line, iteration, expression);
+    }
+
+    // expects a variable named iteration in scope, so that a failure can be reproduced
+#define CHECK(expression) check((expression), #expression, __LINE__, iteration)
+
+    constexpr int64_t infinity = INT64_MAX / 4;
+    constexpr uint32_t none = UINT32_MAX;
+
+    /*
+    Edges are stored sorted and with the smaller node first for undirected graphs, which is the order Graph keeps them in,
+    so that edge i here is edge i of the built graph
+    */
+    struct RandomGraph{
+        uint32_t node_count;
+        bool is_directed;
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t>> edges;
+
+        debug::Graph build(bool weighted = true) const {
+            if(weighted) return debug::Graph(edges, node_count, is_directed);
+            std::vector<std::pair<uint32_t, uint32_t>> pairs;
+            for(const auto& [x, y, w]: edges) pairs.emplace_back(x, y);
+            return debug::Graph(pairs, node_count, is_directed);
+        }
+
+        // every edge as an arc, undirected edges as two arcs
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t>> getArcs() const {
+            std::vector<std::tuple<uint32_t, uint32_t, int64_t>> arcs;
+            for(const auto& [x, y, w]: edges){
+                arcs.emplace_back(x, y, w);
+                if(!is_directed) arcs.emplace_back(y, x, w);
+            }
+            return arcs;
+        }
+
+        int64_t getWeight(uint32_t edge_index) const {
+            return std::get<2>(edges[edge_index]);
+        }
+    };
+
+    RandomGraph makeRandomGraph(std::mt19937& rng, uint32_t max_node_count, uint32_t max_degree, bool is_directed, int64_t min_weight, int64_t max_weight) {
+        RandomGraph res{1 + static_cast<uint32_t>(rng() % max_node_count), is_directed, {}};
+        uint32_t edge_count = static_cast<uint32_t>(rng() % (max_degree * res.node_count + 1));
+        std::uniform_int_distribution<int64_t> weight(min_weight, max_weight);
+        for(uint32_t i = 0; i < edge_count; i++){
+            uint32_t x = static_cast<uint32_t>(rng() % res.node_count), y = static_cast<uint32_t>(rng() % res.node_count);
+            if(!is_directed && x > y) std::swap(x, y);
+            res.edges.emplace_back(x, y, weight(rng));
+        }
+        std::sort(res.edges.begin(), res.edges.end());
+        return res;
+    }
+
+    // Floyd-Warshall over arcs, infinity if there's no path. Only meaningful without negative cycles
+    std::vector<std::vector<int64_t>> findDistancesReference(const RandomGraph& graph) {
+        uint32_t n = graph.node_count;
+        std::vector<std::vector<int64_t>> dist(n, std::vector<int64_t>(n, infinity));
+        for(uint32_t v = 0; v < n; v++) dist[v][v] = 0;
+        for(const auto& [x, y, w]: graph.getArcs()) dist[x][y] = std::min(dist[x][y], w);
+        for(uint32_t k = 0; k < n; k++){
+            for(uint32_t v = 0; v < n; v++){
+                if(dist[v][k] == infinity) continue;
+                for(uint32_t u = 0; u < n; u++){
+                    if(dist[k][u] != infinity) dist[v][u] = std::min(dist[v][u], dist[v][k] + dist[k][u]);
+                }
+            }
+        }
+        return dist;
+    }
+
+    bool matchesReference(const std::optional<int32_t>& distance, int64_t reference) {
+        if(reference == infinity) return !distance.has_value();
+        return distance.has_value() && *distance == reference;
+    }
+
+    // directed weights can be shifted by node potentials, so that they are negative without negative cycles
+    RandomGraph makeDistanceGraph(std::mt19937& rng, uint32_t max_node_count, bool is_directed, bool has_negative_weights) {
+        auto graph = makeRandomGraph(rng, max_node_count, 3, is_directed, 0, 100);
+        if(is_directed && has_negative_weights){
+            std::vector<int64_t> potential(graph.node_count);
+            for(auto& p: potential) p = static_cast<int64_t>(rng() % 60);
+            for(auto& [x, y, w]: graph.edges) w += potential[x] - potential[y];
+        }
+        return graph;
+    }
+
+    struct DisjointSetsReference{
+        std::vector<uint32_t> parent;
+        DisjointSetsReference(uint32_t size): parent(size) { std::iota(parent.begin(), parent.end(), 0); }
+        uint32_t find(uint32_t v) { return parent[v] == v ? v : parent[v] = find(parent[v]); }
+        bool unite(uint32_t a, uint32_t b) {
+            a = find(a);
+            b = find(b);
+            if(a == b) return false;
+            parent[a] = b;
+            return true;
+        }
+    };
+
+    // has_arc[x][y] is set if there is an arc from x to y
+    std::vector<std::vector<char>> getArcMatrix(const RandomGraph& graph) {
+        std::vector<std::vector<char>> has_arc(graph.node_count, std::vector<char>(graph.node_count, 0));
+        for(const auto& [x, y, w]: graph.getArcs()) has_arc[x][y] = 1;
+        return has_arc;
+    }
+
+    // whether the nodes are a cycle along the arcs which visits every node once
+    bool isHamiltonianCycle(const std::vector<std::vector<char>>& has_arc, const std::vector<uint32_t>& cycle) {
+        size_t n = has_arc.size();
+        if(cycle.size() != n) return false;
+        std::vector<char> seen(n, 0);
+        for(size_t j = 0; j < n; j++){
+            uint32_t v = cycle[j], u = cycle[(j + 1) % n];
+            if(v >= n || u >= n || seen[v] || !has_arc[v][u]) return false;
+            seen[v] = 1;
+        }
+        return true;
+    }
+
+    void testBuilder() {
+        std::mt19937 rng(26);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            auto graph = makeRandomGraph(rng, 30, 3, iteration % 2, 1, 20);
+            if(!graph.is_directed && iteration % 4 == 0){
+                // the builder normalizes undirected edges itself
+                for(auto& edge: graph.edges){
+                    if(rng() % 2) std::swap(std::get<0>(edge), std::get<1>(edge));
+                }
+            }
+            auto g = graph.build(is_weighted);
+
+            // edges come in a shuffled order, one by one and in chunks of random sizes
+            auto edges = graph.edges;
+            std::shuffle(edges.begin(), edges.end(), rng);
+            debug::Graph::Builder builder(static_cast<uint32_t>(rng() % (graph.node_count + 1)), graph.is_directed);
+            if(iteration % 5 == 0) builder.reserve(edges.size());
+            for(size_t begin = 0; begin < edges.size();){
+                size_t end = std::min(edges.size(), begin + 1 + rng() % 8);
+                if(end - begin == 1){
+                    auto [x, y, w] = edges[begin];
+                    if(is_weighted) builder.addEdge(x, y, w);
+                    else builder.addEdge(x, y);
+                }
+                else if(is_weighted) builder.addEdges(edges.begin() + static_cast<long>(begin), edges.begin() + static_cast<long>(end));
+                else{
+                    std::vector<std::pair<uint32_t, uint32_t>> chunk;
+                    for(size_t j = begin; j < end; j++) chunk.emplace_back(std::get<0>(edges[j]), std::get<1>(edges[j]));
+                    builder.addEdges(chunk.begin(), chunk.end());
+                }
+                begin = end;
+            }
+            debug::Graph built(std::move(builder));
+
+            // the node count only grows with the edges, so it may be smaller than the one of the random graph
+            uint32_t max_node = 0;
+            for(const auto& [x, y, w]: edges) max_node = std::max({max_node, x + 1, y + 1});
+            CHECK(built.getNodes() <= g.getNodes());
+            CHECK(built.getNodes() >= std::max(max_node, 1u));
+            CHECK(built.getEdges() == g.getEdges());
+            // parallel edges may be in a different order, but the weights of the edges between every two nodes are the same
+            uint32_t source = static_cast<uint32_t>(rng() % built.getNodes());
+            auto distances = built.findDistancesFromNode(source), reference = g.findDistancesFromNode(source);
+            for(uint32_t v = 0; v < built.getNodes(); v++) CHECK(distances[v] == reference[v]);
+        }
+    }
+
+    template<bool Directed>
+    void checkBasicGraph(const RandomGraph& graph, int iteration) {
+        debug::BasicGraph<uint16_t, int64_t, Directed> weighted(graph.edges, graph.node_count);
+        debug::BasicGraph<uint16_t, void, Directed> unweighted(graph.build(false).getEdges(), graph.node_count);
+        auto g = graph.build(), unweighted_g = graph.build(false);
+        CHECK(weighted.getNodes() == graph.node_count);
+        for(uint16_t v = 0; v < graph.node_count; v++){
+            size_t degree = 0;
+            for(const auto& [x, y, w]: graph.edges) degree += (x == v) + (!Directed && y == v);
+            CHECK(weighted.getNeighbours(v).size() == degree);
+        }
+        uint16_t source = static_cast<uint16_t>(iteration % graph.node_count);
+        auto distances = weighted.findDistancesFromNode(source), reference = g.findDistancesFromNode(source);
+        auto hops = unweighted.findDistancesFromNode(source), hops_reference = unweighted_g.findDistancesFromNode(source);
+        for(uint32_t v = 0; v < graph.node_count; v++){
+            CHECK(distances[v].has_value() == reference[v].has_value());
+            CHECK(!distances[v].has_value() || *distances[v] == *reference[v]);
+            CHECK(hops[v].has_value() == hops_reference[v].has_value());
+            CHECK(!hops[v].has_value() || *hops[v] == static_cast<uint16_t>(*hops_reference[v]));
+        }
+    }
+
+    void testBasicGraph() {
+        std::mt19937 rng(27);
+        for(int iteration = 0; iteration < 300; iteration++){
+            auto graph = makeRandomGraph(rng, 30, 3, iteration % 2, 1, 20);
+            if(graph.is_directed) checkBasicGraph<true>(graph, iteration);
+            else checkBasicGraph<false>(graph, iteration);
+        }
+
+        // the largest id is a node too, the node count doesn't fit into NodeId then
+        int iteration = 0;
+        debug::BasicGraph<uint8_t> g(std::vector<std::pair<uint8_t, uint8_t>>{{0, 255}, {255, 255}});
+        CHECK(g.getNodes() == 256);
+        CHECK(g.getNeighbours(255).size() == 3);
+        auto distances = g.findDistancesFromNode(255);
+        CHECK(distances[0] == uint8_t(1));
+        CHECK(!distances[1].has_value());
+    }
+
+    void testDynamicEdges() {
+        std::mt19937 rng(28);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_directed = iteration % 2;
+            auto graph = makeRandomGraph(rng, 12, 2, is_directed, 1, 1);
+            uint32_t n = graph.node_count;
+            // the weight depends only on the ends, so that every copy of an edge is the same
+            auto weightOf = [](uint32_t x, uint32_t y) { return static_cast<int64_t>(1 + (7 * x + 3 * y) % 10); };
+            std::vector<std::pair<uint32_t, uint32_t>> edges;
+            for(auto& [x, y, w]: graph.edges){
+                w = weightOf(x, y);
+                edges.emplace_back(x, y);
+            }
+            auto g = graph.build();
+
+            // the last edge takes the index of the removed one
+            auto removeAt = [&](size_t j) {
+                edges[j] = edges.back();
+                edges.pop_back();
+            };
+            for(int step = 0; step < 60; step++){
+                uint32_t x = static_cast<uint32_t>(rng() % (n + 2)), y = static_cast<uint32_t>(rng() % (n + 2));
+                if(!is_directed && x > y) std::swap(x, y);
+                uint32_t operation = static_cast<uint32_t>(rng() % 3);
+                if(operation == 0 || edges.empty()){
+                    // self-loops and parallel edges are the interesting cases
+                    if(rng() % 4 == 0) y = x;
+                    if(rng() % 4 == 0 && !edges.empty()) std::tie(x, y) = edges[rng() % edges.size()];
+                    CHECK(g.addEdge(x, y, weightOf(x, y)) == edges.size());
+                    edges.emplace_back(x, y);
+                    n = std::max({n, x + 1, y + 1});
+                }
+                else if(operation == 1){
+                    size_t j = rng() % (edges.size() + 1);
+                    g.removeEdgeAt(static_cast<uint32_t>(j));
+                    if(j < edges.size()) removeAt(j);
+                }
+                else{
+                    if(rng() % 2) std::tie(x, y) = edges[rng() % edges.size()];
+                    bool is_present = std::find(edges.begin(), edges.end(), std::make_pair(x, y)) != edges.end();
+                    CHECK(g.removeEdge(x, y) == is_present);
+                    if(!is_present) continue;
+                    // whichever copy was removed, the copies are the same
+                    auto current = g.getEdges();
+                    for(size_t j = 0; j < edges.size(); j++){
+                        if(edges[j] != std::make_pair(x, y)) continue;
+                        auto expected = edges;
+                        expected[j] = expected.back();
+                        expected.pop_back();
+                        if(expected != current) continue;
+                        removeAt(j);
+                        break;
+                    }
+                }
+                CHECK(g.getEdges() == edges);
+            }
+
+            // everything built from the adjacency lists matches a graph built from scratch
+            std::vector<std::tuple<uint32_t, uint32_t, int64_t>> weighted;
+            for(const auto& [x, y]: edges) weighted.emplace_back(x, y, weightOf(x, y));
+            debug::Graph rebuilt(weighted, n, is_directed);
+            CHECK(g.getNodes() == rebuilt.getNodes());
+            uint32_t source = static_cast<uint32_t>(rng() % n);
+            CHECK(g.findDistancesFromNode(source) == rebuilt.findDistancesFromNode(source));
+            CHECK(g.findCoreDecomposition().core_numbers == rebuilt.findCoreDecomposition().core_numbers);
+
+            std::vector<uint32_t> reported(edges.size(), 0);
+            debug::DfsCallbacks callbacks;
+            callbacks.edge = [&](uint32_t v, uint32_t u, uint32_t index, debug::DfsEdgeType type) { reported[index]++; };
+            g.depthFirstSearch(callbacks);
+            for(uint32_t count: reported) CHECK(count == 1);
+
+            g.compact();
+            std::sort(edges.begin(), edges.end());
+            CHECK(g.getEdges() == edges);
+            CHECK(g.findDistancesFromNode(source) == rebuilt.findDistancesFromNode(source));
+        }
+    }
+
+    void testAdjacencyMatrices() {
+        std::mt19937 rng(30);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            auto graph = makeRandomGraph(rng, iteration % 10 == 0 ? 150 : 40, 3, iteration % 2, -20, 20);
+            auto g = graph.build(is_weighted);
+            uint32_t n = graph.node_count;
+
+            // the smallest weight of the arcs between every two nodes
+            std::vector<std::vector<std::optional<int64_t>>> reference(n, std::vector<std::optional<int64_t>>(n));
+            for(const auto& [x, y, w]: graph.getArcs()){
+                int64_t weight = is_weighted ? w : 1;
+                if(!reference[x][y].has_value() || weight < *reference[x][y]) reference[x][y] = weight;
+            }
+
+            auto bits = g.getAdjacencyBitMatrix();
+            auto sparse = g.getSparseAdjacencyMatrix();
+            CHECK(bits.size() == n);
+            CHECK(sparse.size() == n);
+            size_t cell_count = 0;
+            for(uint32_t v = 0; v < n; v++){
+                size_t row_count = 0;
+                for(uint32_t u = 0; u < n; u++){
+                    CHECK(bits.get(v, u) == reference[v][u].has_value());
+                    CHECK(sparse.get(v, u) == reference[v][u]);
+                    row_count += reference[v][u].has_value();
+                }
+                CHECK(bits.countRow(v) == row_count);
+                CHECK(std::is_sorted(sparse.getRowColumnsBegin(v), sparse.getRowColumnsEnd(v)));
+                cell_count += row_count;
+            }
+            CHECK(sparse.getNonZeroCount() == cell_count);
+
+            // common neighbours of two nodes, and the union of their rows
+            uint32_t a = static_cast<uint32_t>(rng() % n), b = static_cast<uint32_t>(rng() % n);
+            size_t common = 0, either = 0;
+            for(uint32_t u = 0; u < n; u++){
+                common += bits.get(a, u) && bits.get(b, u);
+                either += bits.get(a, u) || bits.get(b, u);
+            }
+            CHECK(bits.countAnd(a, b) == common);
+            bits.orRow(a, b);
+            CHECK(bits.countRow(a) == either);
+        }
+    }
+
+    void testPairwiseDistanceMatrix() {
+        std::mt19937 rng(31);
+        for(int iteration = 0; iteration < 200; iteration++){
+            // bigger graphs span several blocks of the tiled Floyd-Warshall
+            auto graph = makeDistanceGraph(rng, iteration % 10 == 0 ? 150 : 25, iteration % 2, iteration % 4 == 1);
+            auto g = graph.build();
+            auto reference = findDistancesReference(graph);
+            auto matrix = g.findPairwiseDistanceMatrix();
+            CHECK(matrix.size() == graph.node_count);
+            for(uint32_t v = 0; v < graph.node_count; v++){
+                for(uint32_t u = 0; u < graph.node_count; u++) CHECK(matchesReference(matrix.get(v, u), reference[v][u]));
+            }
+        }
+
+        // distances far beyond what fits into int32_t still are distances, they saturate
+        int iteration = 0;
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t>> path;
+        for(uint32_t v = 0; v < 5; v++) path.emplace_back(v, v + 1, 1000000000);
+        debug::Graph g(path, 7, true);
+        auto matrix = g.findPairwiseDistanceMatrix();
+        CHECK(matrix.get(0, 2) == 2000000000);
+        CHECK(matrix.get(0, 5) == INT32_MAX);
+        CHECK(!matrix.get(0, 6).has_value());
+    }
+
+    void testPairwiseDistances() {
+        std::mt19937 rng(32);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            auto graph = makeDistanceGraph(rng, 25, iteration % 2, iteration % 4 == 1);
+            if(!is_weighted){
+                for(auto& edge: graph.edges) std::get<2>(edge) = 1;
+            }
+            auto g = graph.build(is_weighted);
+            auto reference = findDistancesReference(graph);
+
+            auto pairwise = g.findPairwiseDistances();
+            for(uint32_t v = 0; v < graph.node_count; v++){
+                for(uint32_t u = 0; u < graph.node_count; u++) CHECK(matchesReference(pairwise[v][u], reference[v][u]));
+            }
+
+            // every row comes exactly once
+            std::vector<uint32_t> row_count(graph.node_count, 0);
+            g.findPairwiseDistances([&](uint32_t v, const std::vector<std::optional<int32_t>>& row) {
+                row_count[v]++;
+                CHECK(row.size() == graph.node_count);
+                for(uint32_t u = 0; u < row.size(); u++) CHECK(matchesReference(row[u], reference[v][u]));
+            });
+            for(uint32_t count: row_count) CHECK(count == 1);
+        }
+    }
+
+    void testDistancesFromNode() {
+        std::mt19937 rng(33);
+        for(int iteration = 0; iteration < 500; iteration++){
+            bool is_directed = iteration % 2;
+            auto graph = makeDistanceGraph(rng, 30, is_directed, iteration % 4 == 1);
+            // acyclic graphs go along the topological order, big weights spread over many radix heap buckets
+            if(iteration % 4 == 3){
+                graph.edges.erase(std::remove_if(graph.edges.begin(), graph.edges.end(), [](const auto& edge) {
+                    return std::get<0>(edge) >= std::get<1>(edge);
+                }), graph.edges.end());
+            }
+            if(iteration % 5 == 0){
+                for(auto& edge: graph.edges) std::get<2>(edge) *= 10007;
+            }
+            bool is_weighted = iteration % 7 != 0;
+            if(!is_weighted){
+                for(auto& edge: graph.edges) std::get<2>(edge) = 1;
+            }
+            auto g = graph.build(is_weighted);
+            auto reference = findDistancesReference(graph);
+            for(uint32_t source = 0; source < graph.node_count; source++){
+                auto distances = g.findDistancesFromNode(source);
+                for(uint32_t v = 0; v < graph.node_count; v++) CHECK(matchesReference(distances[v], reference[source][v]));
+            }
+        }
+
+        // distances far beyond what fits into int32_t saturate
+        int iteration = 0;
+        std::vector<std::tuple<uint32_t, uint32_t, int64_t>> path;
+        for(uint32_t v = 0; v < 5; v++) path.emplace_back(v, v + 1, 1000000000);
+        debug::Graph g(path, 7, true);
+        auto distances = g.findDistancesFromNode(0);
+        CHECK(distances[2] == 2000000000);
+        CHECK(distances[4] == INT32_MAX);
+        CHECK(!distances[6].has_value());
+    }
+
+    void testDeltaStepping() {
+        std::mt19937 rng(34);
+        for(int iteration = 0; iteration < 300; iteration++){
+            // negative weights fall back to the sequential engine
+            auto graph = makeDistanceGraph(rng, iteration % 10 == 0 ? 2000 : 30, iteration % 2, iteration % 8 == 1);
+            auto g = graph.build(iteration % 5 != 0);
+            uint32_t source = static_cast<uint32_t>(rng() % graph.node_count);
+            auto reference = g.findDistancesFromNode(source);
+            // the default delta, one where every edge is light and one where almost every edge is heavy
+            for(int64_t delta: {int64_t(0), int64_t(1000), int64_t(1)}) CHECK(g.findDistancesFromNodeParallel(source, delta) == reference);
+        }
+    }
+
+    void testPointToPointPaths() {
+        std::mt19937 rng(35);
+        for(int iteration = 0; iteration < 500; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            bool has_negative_weights = iteration % 8 == 1;
+            auto graph = makeDistanceGraph(rng, 30, iteration % 2, has_negative_weights);
+            if(!is_weighted){
+                for(auto& edge: graph.edges) std::get<2>(edge) = 1;
+            }
+            auto g = graph.build(is_weighted);
+            auto reference = findDistancesReference(graph);
+            std::vector<std::vector<int64_t>> lightest(graph.node_count, std::vector<int64_t>(graph.node_count, infinity));
+            for(const auto& [x, y, w]: graph.getArcs()) lightest[x][y] = std::min(lightest[x][y], w);
+
+            // the path goes along the arcs from start to finish and is as long as the shortest distance
+            auto checkPath = [&](const std::optional<std::vector<uint32_t>>& path, uint32_t start, uint32_t finish) {
+                CHECK(path.has_value() == (reference[start][finish] != infinity));
+                if(!path.has_value()) return;
+                CHECK(!path->empty() && path->front() == start && path->back() == finish);
+                int64_t cost = 0;
+                for(size_t j = 1; j < path->size(); j++){
+                    int64_t w = lightest[(*path)[j - 1]][(*path)[j]];
+                    CHECK(w != infinity);
+                    cost += w;
+                }
+                CHECK(cost == reference[start][finish]);
+            };
+            for(int query = 0; query < 10; query++){
+                uint32_t start = static_cast<uint32_t>(rng() % graph.node_count), finish = static_cast<uint32_t>(rng() % graph.node_count);
+                checkPath(g.findShortestPathBetweenNodes(start, finish), start, finish);
+                if(has_negative_weights) continue;
+                // no heuristic, the exact distance and a half of it never overestimate
+                checkPath(g.findShortestPathBetweenNodes(start, finish, [](uint32_t v) { return int64_t(0); }), start, finish);
+                for(int64_t divisor: {1, 2}){
+                    auto heuristic = [&](uint32_t v) { return reference[v][finish] == infinity ? 0 : reference[v][finish] / divisor; };
+                    checkPath(g.findShortestPathBetweenNodes(start, finish, heuristic), start, finish);
+                }
+            }
+        }
+    }
+
+    void testBreadthFirstSearch() {
+        std::mt19937 rng(36);
+        for(int iteration = 0; iteration < 200; iteration++){
+            // dense graphs with a small diameter switch to bottom-up steps
+            auto graph = makeRandomGraph(rng, iteration % 10 == 0 ? 2000 : 100, iteration % 3 ? 16 : 2, iteration % 2, 1, 1);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+            uint32_t start = static_cast<uint32_t>(rng() % n);
+
+            std::vector<std::vector<uint32_t>> out(n);
+            for(const auto& [x, y, w]: graph.getArcs()) out[x].push_back(y);
+            std::vector<uint32_t> level(n, none);
+            std::vector<uint32_t> queue = {start};
+            level[start] = 0;
+            for(size_t head = 0; head < queue.size(); head++){
+                for(uint32_t u: out[queue[head]]){
+                    if(level[u] != none) continue;
+                    level[u] = level[queue[head]] + 1;
+                    queue.push_back(u);
+                }
+            }
+
+            for(bool parallel: {false, true}){
+                std::vector<uint32_t> seen_level(n, none);
+                uint32_t expected_level = 0;
+                g.bfsByLevels(start, [&](uint32_t current, const std::vector<uint32_t>& nodes) {
+                    CHECK(current == expected_level++);
+                    for(uint32_t v: nodes){
+                        CHECK(seen_level[v] == none);
+                        seen_level[v] = current;
+                    }
+                }, parallel);
+                CHECK(seen_level == level);
+
+                // every tree edge goes one level down along an arc
+                auto edges = g.getEdges();
+                uint32_t tree_edges = 0;
+                auto f = [&](uint32_t v, uint32_t u, uint32_t index, debug::Graph&) {
+                    tree_edges++;
+                    CHECK(level[u] == level[v] + 1);
+                    auto [x, y] = edges[index];
+                    CHECK((x == v && y == u) || (!graph.is_directed && x == u && y == v));
+                };
+                g.bfs(start, f, parallel);
+                CHECK(tree_edges + 1 == queue.size());
+            }
+        }
+    }
+
+    void testDepthFirstSearch() {
+        std::mt19937 rng(37);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, 30, 3, iteration % 2, 1, 1);
+            auto g = graph.build(false);
+
+            // every edge reachable from the roots is reported exactly once, self-loops included
+            std::vector<uint32_t> reported(graph.edges.size(), 0);
+            uint32_t tree_edges = 0, roots = 0;
+            debug::DfsCallbacks callbacks;
+            callbacks.preorder = [&](uint32_t v, uint32_t parent_edge) { roots += parent_edge == UINT32_MAX; };
+            callbacks.edge = [&](uint32_t v, uint32_t u, uint32_t index, debug::DfsEdgeType type) {
+                reported[index]++;
+                tree_edges += type == debug::DfsEdgeType::tree;
+            };
+            g.depthFirstSearch(callbacks);
+            for(uint32_t count: reported) CHECK(count == 1);
+            CHECK(tree_edges + roots == graph.node_count);
+        }
+    }
+
+    void testEulerianCircuit() {
+        std::mt19937 rng(37);
+        for(int iteration = 0; iteration < 1000; iteration++){
+            bool is_directed = iteration % 2;
+            auto graph = makeRandomGraph(rng, 12, 2, is_directed, 1, 1);
+            uint32_t n = graph.node_count;
+            if(iteration % 3 != 0){
+                // a random closed walk is an Eulerian circuit of its edges
+                graph.edges.clear();
+                uint32_t first = static_cast<uint32_t>(rng() % n), current = first;
+                uint32_t length = static_cast<uint32_t>(rng() % (3 * n));
+                for(uint32_t step = 0; step <= length; step++){
+                    uint32_t next = step == length ? first : static_cast<uint32_t>(rng() % n);
+                    if(!is_directed && current > next) graph.edges.emplace_back(next, current, 1);
+                    else graph.edges.emplace_back(current, next, 1);
+                    current = next;
+                }
+                std::sort(graph.edges.begin(), graph.edges.end());
+            }
+            auto g = graph.build(false);
+
+            // balanced degrees and all edges in one component
+            std::vector<int64_t> balance(n, 0);
+            DisjointSetsReference sets(n);
+            for(const auto& [x, y, w]: graph.edges){
+                balance[x]++;
+                balance[y] += is_directed ? -1 : 1;
+                sets.unite(x, y);
+            }
+            bool is_eulerian = std::all_of(balance.begin(), balance.end(), [&](int64_t b) { return is_directed ? b == 0 : b % 2 == 0; });
+            for(const auto& [x, y, w]: graph.edges) is_eulerian &= sets.find(x) == sets.find(std::get<0>(graph.edges[0]));
+            if(iteration % 3 != 0) CHECK(is_eulerian);
+
+            auto circuit = g.findEulerianCircuit();
+            CHECK(circuit.has_value() == is_eulerian);
+            if(!circuit.has_value()) continue;
+            // a closed walk using every edge exactly once
+            CHECK(circuit->size() == graph.edges.size() + 1);
+            CHECK(circuit->front() == circuit->back());
+            std::vector<std::pair<uint32_t, uint32_t>> walked;
+            for(size_t j = 1; j < circuit->size(); j++){
+                uint32_t x = (*circuit)[j - 1], y = (*circuit)[j];
+                if(!is_directed && x > y) std::swap(x, y);
+                walked.emplace_back(x, y);
+            }
+            std::sort(walked.begin(), walked.end());
+            CHECK(walked == g.getEdges());
+        }
+    }
+
+    void testHamiltonianCycle() {
+        std::mt19937 rng(38);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, 6, 3, iteration % 2, 1, 1);
+            // a cycle needs at least 3 nodes, more nodes are added to some graphs
+            graph.node_count += 2 + static_cast<uint32_t>(rng() % 3);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+            auto has_arc = getArcMatrix(graph);
+
+            // every order of the nodes starting with 0
+            std::vector<uint32_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            bool is_hamiltonian = false;
+            do{
+                is_hamiltonian = isHamiltonianCycle(has_arc, order);
+            } while(!is_hamiltonian && std::next_permutation(order.begin() + 1, order.end()));
+
+            auto cycle = g.findHamiltonianCycle();
+            CHECK(cycle.has_value() == is_hamiltonian);
+            if(cycle.has_value()) CHECK(isHamiltonianCycle(has_arc, *cycle));
+            debug::HamiltonianSearchOptions options;
+            options.parallel = false;
+            auto sequential = g.findHamiltonianCycle(options);
+            CHECK(sequential.is_complete);
+            CHECK(sequential.cycle.has_value() == is_hamiltonian);
+            if(sequential.cycle.has_value()) CHECK(isHamiltonianCycle(has_arc, *sequential.cycle));
+        }
+    }
+
+    void testHamiltonianSearchModes() {
+        std::mt19937 rng(39);
+        for(int iteration = 0; iteration < 16; iteration++){
+            // graphs too big for the DP, with a hidden cycle and a few more edges, or with a node that has only one neighbour
+            bool is_directed = iteration % 2;
+            RandomGraph graph{29 + static_cast<uint32_t>(rng() % 4), is_directed, {}};
+            uint32_t n = graph.node_count;
+            std::vector<uint32_t> hidden(n);
+            std::iota(hidden.begin(), hidden.end(), 0);
+            std::shuffle(hidden.begin(), hidden.end(), rng);
+            bool is_hamiltonian = iteration % 4 < 2;
+            for(uint32_t j = 0; j < n; j++){
+                uint32_t x = hidden[j], y = hidden[(j + 1) % n];
+                if(!is_hamiltonian && (x == hidden[0] || y == hidden[0])) continue;
+                graph.edges.emplace_back(x, y, 1);
+            }
+            if(!is_hamiltonian) graph.edges.emplace_back(hidden[0], hidden[1], 1);
+            for(uint32_t j = 0; j < n; j++){
+                uint32_t x = static_cast<uint32_t>(rng() % n), y = static_cast<uint32_t>(rng() % n);
+                if(!is_hamiltonian && (x == hidden[0] || y == hidden[0])) continue;
+                graph.edges.emplace_back(x, y, 1);
+            }
+            for(auto& [x, y, w]: graph.edges){
+                if(!is_directed && x > y) std::swap(x, y);
+            }
+            std::sort(graph.edges.begin(), graph.edges.end());
+            auto g = graph.build(false);
+            auto has_arc = getArcMatrix(graph);
+
+            for(bool parallel: {false, true}){
+                debug::HamiltonianSearchOptions options;
+                options.parallel = parallel;
+                auto result = g.findHamiltonianCycle(options);
+                CHECK(result.is_complete);
+                CHECK(result.cycle.has_value() == is_hamiltonian);
+                if(result.cycle.has_value()) CHECK(isHamiltonianCycle(has_arc, *result.cycle));
+            }
+        }
+
+        // two sides of a bipartite graph that differ in size have no Hamiltonian cycle, but nothing cheap rules it out
+        int iteration = 0;
+        const uint32_t left = 16, right = 17;
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        for(uint32_t v = 0; v < left; v++){
+            for(uint32_t u = left; u < left + right; u++){
+                if((v + u) % 3 != 0) edges.emplace_back(v, u);
+            }
+        }
+        debug::Graph g(edges, left + right);
+        for(bool parallel: {false, true}){
+            debug::HamiltonianSearchOptions options;
+            options.parallel = parallel;
+            options.time_budget = std::chrono::milliseconds(50);
+            auto start = std::chrono::steady_clock::now();
+            auto result = g.findHamiltonianCycle(options);
+            CHECK(!result.cycle.has_value());
+            CHECK(!result.is_complete);
+            CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+            // the progress goes from 0 to 1, returning false stops the search
+            options.time_budget = std::chrono::milliseconds(0);
+            double last_progress = 0;
+            uint32_t calls = 0;
+            options.progress = [&](double progress) {
+                CHECK(progress >= last_progress && progress <= 1);
+                last_progress = progress;
+                return ++calls < 3;
+            };
+            result = g.findHamiltonianCycle(options);
+            CHECK(!result.cycle.has_value());
+            CHECK(!result.is_complete);
+            CHECK(calls == 3);
+        }
+    }
+
+    void testSpanningTree() {
+        std::mt19937 rng(40);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_weighted = iteration % 5 != 0;
+            auto graph = makeRandomGraph(rng, iteration % 10 == 0 ? 2000 : 40, 4, iteration % 4 == 1, iteration % 2 ? -100 : 0, iteration % 3 ? 1000000 : 3);
+            if(!is_weighted){
+                for(auto& edge: graph.edges) std::get<2>(edge) = 1;
+            }
+            auto g = graph.build(is_weighted);
+
+            // plain Kruskal over all edges sorted by weight
+            std::vector<uint32_t> indices(graph.edges.size());
+            std::iota(indices.begin(), indices.end(), 0);
+            std::stable_sort(indices.begin(), indices.end(), [&](uint32_t a, uint32_t b) { return graph.getWeight(a) < graph.getWeight(b); });
+            DisjointSetsReference sets(graph.node_count);
+            int64_t reference_weight = 0;
+            size_t reference_size = 0;
+            for(uint32_t i: indices){
+                if(!sets.unite(std::get<0>(graph.edges[i]), std::get<1>(graph.edges[i]))) continue;
+                reference_weight += graph.getWeight(i);
+                reference_size++;
+            }
+
+            for(const auto& forest: {g.findMinimumSpanningTree(), g.findMinimumSpanningTreeParallel()}){
+                DisjointSetsReference forest_sets(graph.node_count);
+                int64_t weight = 0;
+                for(uint32_t i: forest){
+                    CHECK(forest_sets.unite(std::get<0>(graph.edges[i]), std::get<1>(graph.edges[i])));
+                    weight += graph.getWeight(i);
+                }
+                CHECK(forest.size() == reference_size);
+                CHECK(weight == reference_weight);
+            }
+        }
+    }
+
+    void testStronglyConnectedComponents() {
+        std::mt19937 rng(41);
+        for(int iteration = 0; iteration < 500; iteration++){
+            bool is_directed = iteration % 4 != 0;
+            auto graph = makeRandomGraph(rng, 30, iteration % 3 == 0 ? 2 : 1, is_directed, 1, 1);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+
+            // transitive closure, two nodes are in one component if they reach each other
+            auto reach = getArcMatrix(graph);
+            for(uint32_t v = 0; v < n; v++) reach[v][v] = 1;
+            for(uint32_t k = 0; k < n; k++){
+                for(uint32_t v = 0; v < n; v++){
+                    if(!reach[v][k]) continue;
+                    for(uint32_t u = 0; u < n; u++) reach[v][u] |= reach[k][u];
+                }
+            }
+
+            auto component = g.findStronglyConnectedComponents();
+            CHECK(component.size() == n);
+            uint32_t count = 0;
+            for(uint32_t v = 0; v < n; v++){
+                count = std::max(count, component[v] + 1);
+                for(uint32_t u = 0; u < n; u++) CHECK((component[v] == component[u]) == (reach[v][u] && reach[u][v]));
+            }
+            // components are numbered in topological order of the condensation
+            std::vector<std::pair<uint32_t, uint32_t>> condensation_edges;
+            for(const auto& [x, y, w]: graph.edges){
+                if(!is_directed || component[x] == component[y]) continue;
+                CHECK(component[x] < component[y]);
+                condensation_edges.emplace_back(component[x], component[y]);
+            }
+            std::sort(condensation_edges.begin(), condensation_edges.end());
+            condensation_edges.erase(std::unique(condensation_edges.begin(), condensation_edges.end()), condensation_edges.end());
+
+            auto condensation = g.getCondensation();
+            CHECK(condensation.getNodes() == std::max(count, 1u));
+            CHECK(condensation.getEdges() == condensation_edges);
+        }
+    }
+
+    void testConnectedComponents() {
+        std::mt19937 rng(42);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, iteration % 10 == 0 ? 3000 : 40, 1, iteration % 2, 1, 1);
+            auto g = graph.build(false);
+            DisjointSetsReference sets(graph.node_count);
+            for(const auto& [x, y, w]: graph.edges) sets.unite(x, y);
+
+            // components are numbered in the order of their smallest nodes
+            auto component = g.findConnectedComponentsParallel();
+            std::vector<uint32_t> reference(graph.node_count), id_of_root(graph.node_count, none);
+            uint32_t count = 0;
+            for(uint32_t v = 0; v < graph.node_count; v++){
+                uint32_t root = sets.find(v);
+                if(id_of_root[root] == none) id_of_root[root] = count++;
+                reference[v] = id_of_root[root];
+            }
+            CHECK(component == reference);
+        }
+    }
+
+    void testBiconnectedComponents() {
+        std::mt19937 rng(43);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, 25, iteration % 3 == 0 ? 2 : 1, iteration % 4 == 1, 1, 1);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+            const auto& edges = graph.edges;
+
+            // components of the nodes which aren't removed over the edges which aren't removed
+            auto countComponents = [&](uint32_t removed_node, size_t removed_edge) {
+                DisjointSetsReference sets(n);
+                uint32_t count = n - (removed_node != none);
+                for(size_t j = 0; j < edges.size(); j++){
+                    auto [x, y, w] = edges[j];
+                    if(j == removed_edge || x == removed_node || y == removed_node) continue;
+                    count -= sets.unite(x, y);
+                }
+                return count;
+            };
+            uint32_t component_count = countComponents(none, edges.size());
+
+            auto components = g.findBiconnectedComponents();
+            std::vector<char> is_bridge(edges.size(), 0);
+            for(uint32_t i: components.bridges) is_bridge[i] = 1;
+            for(size_t j = 0; j < edges.size(); j++) CHECK(static_cast<bool>(is_bridge[j]) == (countComponents(none, j) > component_count));
+
+            // a node without other neighbours is a component which disappears with it
+            std::vector<char> has_neighbours(n, 0);
+            for(const auto& [x, y, w]: edges){
+                if(x != y) has_neighbours[x] = has_neighbours[y] = 1;
+            }
+            std::vector<uint32_t> articulation_points;
+            for(uint32_t v = 0; v < n; v++){
+                if(countComponents(v, edges.size()) > component_count - !has_neighbours[v]) articulation_points.push_back(v);
+            }
+            CHECK(components.articulation_points == articulation_points);
+
+            // bridges are blocks of one edge, self-loops are in no block
+            std::vector<uint32_t> block_size(components.block_count, 0);
+            for(size_t j = 0; j < edges.size(); j++){
+                uint32_t block = components.edge_blocks[j];
+                bool is_self_loop = std::get<0>(edges[j]) == std::get<1>(edges[j]);
+                CHECK((block == none) == is_self_loop);
+                if(block != none && block < components.block_count) block_size[block]++;
+            }
+            for(uint32_t i: components.bridges) CHECK(block_size[components.edge_blocks[i]] == 1);
+            CHECK(std::count(block_size.begin(), block_size.end(), 0u) == 0);
+
+            // the block-cut tree is a forest
+            DisjointSetsReference tree(components.block_count + static_cast<uint32_t>(articulation_points.size()));
+            for(const auto& [block, point]: components.block_cut_tree) CHECK(tree.unite(block, point));
+        }
+    }
+
+    void testMaxFlow() {
+        std::mt19937 rng(44);
+        for(int iteration = 0; iteration < 500; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            auto graph = makeRandomGraph(rng, 10, 3, iteration % 4 != 0, -3, 10);
+            graph.node_count = std::max(graph.node_count, 2u);
+            auto g = graph.build(is_weighted);
+            uint32_t n = graph.node_count;
+            uint32_t source = static_cast<uint32_t>(rng() % n), sink = static_cast<uint32_t>(rng() % (n - 1));
+            if(sink >= source) sink++;
+
+            // negative weights are no capacity, undirected edges are cut if their ends are on different sides
+            auto capacity = [&](size_t j) { return is_weighted ? std::max<int64_t>(std::get<2>(graph.edges[j]), 0) : 1; };
+            auto cutCapacity = [&](const std::vector<char>& side) {
+                int64_t res = 0;
+                for(size_t j = 0; j < graph.edges.size(); j++){
+                    auto [x, y, w] = graph.edges[j];
+                    if(side[x] && !side[y]) res += capacity(j);
+                    else if(!graph.is_directed && side[y] && !side[x]) res += capacity(j);
+                }
+                return res;
+            };
+            int64_t min_cut = infinity;
+            for(uint32_t mask = 0; mask < (1u << n); mask++){
+                if(!(mask >> source & 1) || (mask >> sink & 1)) continue;
+                std::vector<char> side(n);
+                for(uint32_t v = 0; v < n; v++) side[v] = mask >> v & 1;
+                min_cut = std::min(min_cut, cutCapacity(side));
+            }
+
+            for(auto algorithm: {debug::MaxFlowAlgorithm::dinic, debug::MaxFlowAlgorithm::push_relabel}){
+                auto flow = g.findMaxFlow(source, sink, algorithm);
+                CHECK(flow.value == min_cut);
+                CHECK(flow.source_side.size() == n && flow.edge_flows.size() == graph.edges.size());
+                if(flow.source_side.size() != n || flow.edge_flows.size() != graph.edges.size()) continue;
+                CHECK(flow.source_side[source] && !flow.source_side[sink]);
+                CHECK(cutCapacity(flow.source_side) == flow.value);
+
+                // flows fit into the capacities and every node but the source and the sink keeps what comes in
+                std::vector<int64_t> excess(n, 0);
+                for(size_t j = 0; j < graph.edges.size(); j++){
+                    auto [x, y, w] = graph.edges[j];
+                    int64_t f = flow.edge_flows[j];
+                    CHECK(f <= capacity(j) && (graph.is_directed ? f >= 0 : f >= -capacity(j)));
+                    excess[x] -= f;
+                    excess[y] += f;
+                }
+                for(uint32_t v = 0; v < n; v++){
+                    if(v == source) CHECK(excess[v] == -flow.value);
+                    else if(v == sink) CHECK(excess[v] == flow.value);
+                    else CHECK(excess[v] == 0);
+                }
+            }
+        }
+    }
+
+    void testMatching() {
+        std::mt19937 rng(45);
+        for(int iteration = 0; iteration < 1000; iteration++){
+            bool is_directed = iteration % 2;
+            auto graph = makeRandomGraph(rng, 24, 3, is_directed, 1, 1);
+            uint32_t n = graph.node_count;
+            if(iteration % 3 != 0){
+                // keep only the edges between two random sides, so that most graphs are bipartite
+                std::vector<uint8_t> side(n);
+                for(auto& s: side) s = static_cast<uint8_t>(rng() % 2);
+                graph.edges.erase(std::remove_if(graph.edges.begin(), graph.edges.end(), [&](const auto& edge) {
+                    return side[std::get<0>(edge)] == side[std::get<1>(edge)];
+                }), graph.edges.end());
+            }
+            auto g = graph.build(false);
+
+            // 2-coloring by BFS over the undirected edges
+            std::vector<int> color(n, -1);
+            bool is_bipartite = true;
+            for(uint32_t root = 0; root < n; root++){
+                if(color[root] >= 0) continue;
+                color[root] = 0;
+                std::vector<uint32_t> queue = {root};
+                for(size_t head = 0; head < queue.size(); head++){
+                    for(const auto& [x, y, w]: graph.getArcs()){
+                        uint32_t a = x, b = y;
+                        if(b == queue[head]) std::swap(a, b);
+                        if(a != queue[head]) continue;
+                        if(color[b] < 0){
+                            color[b] = color[a] ^ 1;
+                            queue.push_back(b);
+                        }
+                        else if(color[b] == color[a]) is_bipartite = false;
+                    }
+                }
+            }
+
+            auto sides = g.findBipartition();
+            auto matching = g.findMaximumMatching();
+            CHECK(sides.has_value() == is_bipartite);
+            CHECK(matching.has_value() == is_bipartite);
+            if(!sides.has_value() || !matching.has_value()) continue;
+            for(const auto& [x, y, w]: graph.edges) CHECK((*sides)[x] != (*sides)[y]);
+
+            std::vector<char> is_matched(n, 0);
+            for(uint32_t i: *matching){
+                auto [x, y, w] = graph.edges[i];
+                CHECK(!is_matched[x] && !is_matched[y]);
+                is_matched[x] = is_matched[y] = 1;
+            }
+
+            // unit capacities source -> side 0 -> side 1 -> sink, the maximum flow is the size of a maximum matching
+            uint32_t source = n, sink = n + 1;
+            std::vector<std::pair<uint32_t, uint32_t>> network;
+            for(uint32_t v = 0; v < n; v++){
+                if((*sides)[v] == 0) network.emplace_back(source, v);
+                else network.emplace_back(v, sink);
+            }
+            for(auto [x, y, w]: graph.edges){
+                if((*sides)[x] != 0) std::swap(x, y);
+                network.emplace_back(x, y);
+            }
+            debug::Graph flow_graph(network, n + 2, true);
+            for(auto algorithm: {debug::MaxFlowAlgorithm::dinic, debug::MaxFlowAlgorithm::push_relabel}){
+                CHECK(flow_graph.findMaxFlow(source, sink, algorithm).value == static_cast<int64_t>(matching->size()));
+            }
+        }
+    }
+
+    void testTopologicalSort() {
+        std::mt19937 rng(46);
+        for(int iteration = 0; iteration < 1000; iteration++){
+            auto graph = makeRandomGraph(rng, 20, 2, true, 1, 1);
+            bool make_acyclic = iteration % 3 != 0;
+            if(make_acyclic){
+                // orient every edge along a random permutation
+                std::vector<uint32_t> rank(graph.node_count);
+                std::iota(rank.begin(), rank.end(), 0);
+                std::shuffle(rank.begin(), rank.end(), rng);
+                std::vector<std::tuple<uint32_t, uint32_t, int64_t>> edges;
+                for(auto [x, y, w]: graph.edges){
+                    if(x == y) continue;
+                    if(rank[x] > rank[y]) std::swap(x, y);
+                    edges.emplace_back(x, y, w);
+                }
+                std::sort(edges.begin(), edges.end());
+                graph.edges = std::move(edges);
+            }
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+
+            // repeatedly removing the nodes without incoming edges leaves exactly the nodes reachable from cycles
+            std::vector<uint32_t> in_degree(n, 0);
+            for(const auto& [x, y, w]: graph.edges) in_degree[y]++;
+            std::vector<char> removed(n, 0);
+            bool changed = true;
+            while(changed){
+                changed = false;
+                for(uint32_t v = 0; v < n; v++){
+                    if(removed[v] || in_degree[v]) continue;
+                    removed[v] = 1;
+                    changed = true;
+                    for(const auto& [x, y, w]: graph.edges){
+                        if(x == v) in_degree[y]--;
+                    }
+                }
+            }
+            bool is_acyclic = std::count(removed.begin(), removed.end(), 1) == static_cast<long>(n);
+            CHECK(!make_acyclic || is_acyclic);
+
+            auto sort = g.findTopologicalSort();
+            CHECK(sort.cycle.empty() == is_acyclic);
+            std::vector<uint32_t> position(n, none);
+            for(uint32_t j = 0; j < sort.order.size(); j++) position[sort.order[j]] = j;
+            for(uint32_t v = 0; v < n; v++) CHECK((position[v] != none) == static_cast<bool>(removed[v]));
+            for(const auto& [x, y, w]: graph.edges){
+                if(position[x] != none && position[y] != none) CHECK(position[x] < position[y]);
+            }
+
+            // the witness is a simple cycle along the edges
+            const auto& cycle = sort.cycle;
+            for(size_t j = 0; j < cycle.size(); j++){
+                uint32_t x = cycle[j], y = cycle[(j + 1) % cycle.size()];
+                bool is_edge = std::any_of(graph.edges.begin(), graph.edges.end(), [&](const auto& edge) {
+                    return std::get<0>(edge) == x && std::get<1>(edge) == y;
+                });
+                CHECK(is_edge);
+            }
+            auto distinct = cycle;
+            std::sort(distinct.begin(), distinct.end());
+            CHECK(std::unique(distinct.begin(), distinct.end()) == distinct.end());
+        }
+    }
+
+    void testLongestDistances() {
+        std::mt19937 rng(46);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, 20, 2, true, -10, 10);
+            bool make_acyclic = iteration % 4 != 0;
+            if(make_acyclic){
+                // orient every edge along a random permutation
+                std::vector<uint32_t> rank(graph.node_count);
+                std::iota(rank.begin(), rank.end(), 0);
+                std::shuffle(rank.begin(), rank.end(), rng);
+                std::vector<std::tuple<uint32_t, uint32_t, int64_t>> edges;
+                for(auto [x, y, w]: graph.edges){
+                    if(x == y) continue;
+                    if(rank[x] > rank[y]) std::swap(x, y);
+                    edges.emplace_back(x, y, w);
+                }
+                std::sort(edges.begin(), edges.end());
+                graph.edges = std::move(edges);
+            }
+            auto g = graph.build();
+            uint32_t n = graph.node_count;
+            bool is_acyclic = g.findTopologicalSort().cycle.empty();
+            CHECK(!make_acyclic || is_acyclic);
+
+            // the longest distances are the shortest ones with negated weights, there are no cycles to make them unbounded
+            auto negated = graph;
+            for(auto& edge: negated.edges) std::get<2>(edge) = -std::get<2>(edge);
+            auto reference = findDistancesReference(negated);
+            std::vector<std::vector<int64_t>> heaviest(n, std::vector<int64_t>(n, -infinity));
+            for(const auto& [x, y, w]: graph.edges) heaviest[x][y] = std::max(heaviest[x][y], w);
+
+            uint32_t source = static_cast<uint32_t>(rng() % n);
+            auto distances = g.findLongestDistancesFromNode(source);
+            CHECK(distances.has_value() == is_acyclic);
+            for(uint32_t finish = 0; finish < n; finish++){
+                auto path = g.findLongestPathBetweenNodes(source, finish);
+                if(!is_acyclic){
+                    CHECK(!path.has_value());
+                    continue;
+                }
+                int64_t longest = reference[source][finish] == infinity ? infinity : -reference[source][finish];
+                CHECK(matchesReference((*distances)[finish], longest));
+                CHECK(path.has_value() == (longest != infinity));
+                if(!path.has_value()) continue;
+                CHECK(!path->empty() && path->front() == source && path->back() == finish);
+                int64_t cost = 0;
+                for(size_t j = 1; j < path->size(); j++){
+                    int64_t w = heaviest[(*path)[j - 1]][(*path)[j]];
+                    CHECK(w != -infinity);
+                    cost += w;
+                }
+                CHECK(cost == longest);
+            }
+        }
+    }
+
+    void testNegativeCycle() {
+        std::mt19937 rng(47);
+        for(int iteration = 0; iteration < 1000; iteration++){
+            bool is_directed = iteration % 4 != 0;
+            auto graph = makeRandomGraph(rng, 20, 3, is_directed, iteration % 3 == 0 ? -3 : -1, 12);
+            auto g = graph.build();
+            auto arcs = graph.getArcs();
+
+            // Bellman-Ford from a virtual source connected to every node: a relaxation in the n-th round means a negative cycle
+            uint32_t n = graph.node_count;
+            std::vector<int64_t> potential(n, 0);
+            bool has_negative_cycle = false;
+            for(uint32_t round = 0; round <= n; round++){
+                bool changed = false;
+                for(const auto& [x, y, w]: arcs){
+                    if(potential[x] + w < potential[y]){
+                        potential[y] = potential[x] + w;
+                        changed = true;
+                    }
+                }
+                if(!changed) break;
+                if(round == n) has_negative_cycle = true;
+            }
+
+            auto cycle = g.findNegativeCycle();
+            CHECK(cycle.has_value() == has_negative_cycle);
+            if(!cycle.has_value() || cycle->empty()) continue;
+
+            // the witness must be a closed walk along the edges with a negative total weight, undirected edges go either way
+            const auto& edges = graph.edges;
+            auto [first_x, first_y, first_w] = edges[cycle->front()];
+            bool is_closed_walk = false;
+            int64_t total = 0;
+            for(int orientation = 0; orientation < (is_directed ? 1 : 2) && !is_closed_walk; orientation++){
+                uint32_t start = orientation ? first_y : first_x, current = orientation ? first_x : first_y;
+                bool ok = true;
+                total = first_w;
+                for(size_t j = 1; j < cycle->size(); j++){
+                    auto [x, y, w] = edges[(*cycle)[j]];
+                    if(x == current) current = y;
+                    else if(!is_directed && y == current) current = x;
+                    else ok = false;
+                    total += w;
+                }
+                is_closed_walk = ok && current == start;
+            }
+            CHECK(is_closed_walk);
+            CHECK(total < 0);
+        }
+    }
+
+    void testBetweennessCentrality() {
+        std::mt19937 rng(48);
+        for(int iteration = 0; iteration < 300; iteration++){
+            bool is_weighted = iteration % 3 != 0;
+            auto graph = makeRandomGraph(rng, 15, 3, iteration % 2, 1, is_weighted ? 3 : 1);
+            auto g = graph.build(is_weighted);
+            uint32_t n = graph.node_count;
+
+            // distances and numbers of shortest paths for every pair by a quadratic Dijkstra, parallel edges are different paths
+            auto arcs = graph.getArcs();
+            std::vector<std::vector<int64_t>> dist(n, std::vector<int64_t>(n, infinity));
+            std::vector<std::vector<double>> paths(n, std::vector<double>(n, 0));
+            for(uint32_t s = 0; s < n; s++){
+                dist[s][s] = 0;
+                paths[s][s] = 1;
+                std::vector<char> done(n, 0);
+                while(true){
+                    uint32_t v = none;
+                    for(uint32_t u = 0; u < n; u++){
+                        if(!done[u] && dist[s][u] != infinity && (v == none || dist[s][u] < dist[s][v])) v = u;
+                    }
+                    if(v == none) break;
+                    done[v] = 1;
+                    for(const auto& [x, y, w]: arcs){
+                        if(x != v || x == y) continue;
+                        if(dist[s][v] + w < dist[s][y]){
+                            dist[s][y] = dist[s][v] + w;
+                            paths[s][y] = paths[s][v];
+                        }
+                        else if(dist[s][v] + w == dist[s][y]) paths[s][y] += paths[s][v];
+                    }
+                }
+            }
+            std::vector<double> reference(n, 0);
+            for(uint32_t s = 0; s < n; s++){
+                for(uint32_t t = 0; t < n; t++){
+                    if(s == t || dist[s][t] == infinity) continue;
+                    for(uint32_t v = 0; v < n; v++){
+                        if(v != s && v != t && dist[s][v] + dist[v][t] == dist[s][t]) reference[v] += paths[s][v] * paths[v][t] / paths[s][t];
+                    }
+                }
+            }
+            if(!graph.is_directed){
+                for(auto& c: reference) c /= 2;
+            }
+
+            auto centrality = g.findBetweennessCentrality();
+            CHECK(centrality.has_value());
+            if(!centrality.has_value()) continue;
+            for(uint32_t v = 0; v < n; v++) CHECK(std::fabs((*centrality)[v] - reference[v]) < 1e-6);
+        }
+
+        int iteration = 0;
+        debug::Graph zero_weight(std::vector<std::tuple<uint32_t, uint32_t, int64_t>>{{0, 1, 1}, {1, 2, 0}}, 3);
+        CHECK(!zero_weight.findBetweennessCentrality().has_value());
+    }
+
+    void testPageRank() {
+        std::mt19937 rng(49);
+        for(int iteration = 0; iteration < 300; iteration++){
+            auto graph = makeRandomGraph(rng, 30, 3, iteration % 2, 1, 1);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+
+            debug::PageRankOptions options;
+            options.tolerance = 1e-13;
+            options.max_iterations = 1000;
+            std::vector<double> teleport(n, 1.0 / n);
+            if(iteration % 3 == 0){
+                options.personalization.assign(n, 0);
+                options.personalization[rng() % n] += 2;
+                options.personalization[rng() % n] += 1;
+                for(uint32_t v = 0; v < n; v++) teleport[v] = options.personalization[v] / 3;
+            }
+
+            // power iteration over the arcs, the rank of the nodes without outgoing arcs is spread like the random jumps
+            auto arcs = graph.getArcs();
+            std::vector<uint32_t> out_degree(n, 0);
+            for(const auto& [x, y, w]: arcs) out_degree[x]++;
+            std::vector<double> rank = teleport;
+            for(int step = 0; step < 2000; step++){
+                std::vector<double> next(n, 0);
+                double dangling = 0;
+                for(uint32_t v = 0; v < n; v++){
+                    if(out_degree[v] == 0) dangling += rank[v];
+                }
+                for(const auto& [x, y, w]: arcs) next[y] += options.damping * rank[x] / out_degree[x];
+                for(uint32_t v = 0; v < n; v++) next[v] += (1 - options.damping + options.damping * dangling) * teleport[v];
+                rank = std::move(next);
+            }
+
+            auto result = g.findPageRank(options);
+            CHECK(result.is_converged);
+            CHECK(std::fabs(std::accumulate(result.ranks.begin(), result.ranks.end(), 0.0) - 1) < 1e-9);
+            for(uint32_t v = 0; v < n; v++) CHECK(std::fabs(result.ranks[v] - rank[v]) < 1e-9);
+        }
+    }
+
+    void testCoreDecomposition() {
+        std::mt19937 rng(50);
+        for(int iteration = 0; iteration < 500; iteration++){
+            auto graph = makeRandomGraph(rng, 25, 4, iteration % 2, 1, 1);
+            auto g = graph.build(false);
+            uint32_t n = graph.node_count;
+
+            // self-loops are ignored and parallel edges count every time, in both directions for directed graphs
+            std::vector<std::vector<uint32_t>> neighbours(n);
+            for(const auto& [x, y, w]: graph.edges){
+                if(x == y) continue;
+                neighbours[x].push_back(y);
+                neighbours[y].push_back(x);
+            }
+            // the k-core is what's left after removing the nodes with less than k neighbours until there are none
+            std::vector<uint32_t> reference(n, 0);
+            for(uint32_t k = 1; k <= 4 * n; k++){
+                std::vector<char> alive(n, 1);
+                bool changed = true;
+                while(changed){
+                    changed = false;
+                    for(uint32_t v = 0; v < n; v++){
+                        if(!alive[v]) continue;
+                        uint32_t degree = 0;
+                        for(uint32_t u: neighbours[v]) degree += alive[u];
+                        if(degree < k){
+                            alive[v] = 0;
+                            changed = true;
+                        }
+                    }
+                }
+                for(uint32_t v = 0; v < n; v++){
+                    if(alive[v]) reference[v] = k;
+                }
+            }
+
+            auto cores = g.findCoreDecomposition();
+            CHECK(cores.core_numbers == reference);
+            CHECK(cores.degeneracy == *std::max_element(reference.begin(), reference.end()));
+            std::vector<uint32_t> position(n, none);
+            for(uint32_t j = 0; j < cores.degeneracy_order.size(); j++) position[cores.degeneracy_order[j]] = j;
+            for(uint32_t v = 0; v < n; v++){
+                CHECK(position[v] != none);
+                uint32_t later = 0;
+                for(uint32_t u: neighbours[v]) later += position[u] > position[v];
+                CHECK(later <= cores.degeneracy);
+            }
+
+            uint32_t k = static_cast<uint32_t>(rng() % 4);
+            auto core = g.getCore(k);
+            size_t edge_count = 0;
+            for(const auto& [x, y, w]: graph.edges) edge_count += reference[x] >= k && reference[y] >= k;
+            // a graph has at least one node, even if the k-core is empty
+            auto node_count = static_cast<uint32_t>(std::count_if(reference.begin(), reference.end(), [k](uint32_t c) { return c >= k; }));
+            CHECK(core.getNodes() == std::max(node_count, 1u));
+            CHECK(core.getEdges().size() == edge_count);
+        }
+    }
+
+    const std::vector<std::pair<const char*, std::function<void()>>> tests = {
+        {"builder", testBuilder},
+        {"basic-graph", testBasicGraph},
+        {"dynamic-edges", testDynamicEdges},
+        {"adjacency-matrices", testAdjacencyMatrices},
+        {"pairwise-distance-matrix", testPairwiseDistanceMatrix},
+        {"pairwise-distances", testPairwiseDistances},
+        {"distances-from-node", testDistancesFromNode},
+        {"delta-stepping", testDeltaStepping},
+        {"point-to-point-paths", testPointToPointPaths},
+        {"breadth-first-search", testBreadthFirstSearch},
+        {"depth-first-search", testDepthFirstSearch},
+        {"eulerian-circuit", testEulerianCircuit},
+        {"hamiltonian-cycle", testHamiltonianCycle},
+        {"hamiltonian-search-modes", testHamiltonianSearchModes},
+        {"spanning-tree", testSpanningTree},
+        {"strongly-connected-components", testStronglyConnectedComponents},
+        {"connected-components", testConnectedComponents},
+        {"biconnected-components", testBiconnectedComponents},
+        {"max-flow", testMaxFlow},
+        {"matching", testMatching},
+        {"topological-sort", testTopologicalSort},
+        {"longest-distances", testLongestDistances},
+        {"negative-cycle", testNegativeCycle},
+        {"betweenness-centrality", testBetweennessCentrality},
+        {"pagerank", testPageRank},
+        {"core-decomposition", testCoreDecomposition},
+    };
+}
+
+int main(int argc, char** argv) {
+    const char* name = argc > 1 ? argv[1] : "all";
+    // more threads than there might be cores, so that the parallel paths run even on small machines
+    debug::setThreadCount(4);
+
+    bool found = false;
+    for(const auto& [test_name, run]: tests){
+        if(std::strcmp(name, "all") != 0 && std::strcmp(name, test_name) != 0) continue;
+        found = true;
+        int failures_before = failures;
+        run();
+        std::printf("%s: %s\n", test_name, failures == failures_before ? "passed" : "FAILED");
+    }
+    if(!found){
+        std::fprintf(stderr, "unknown test %s, the options are: all", name);
+        for(const auto& test: tests) std::fprintf(stderr, " %s", test.first);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}